@@ -31,7 +31,8 @@ exclude = [
 	"flags.observer.json",
 	"pack.world.json",
 	"bonded.forcefield.json",
-	"nonbonded.forcefield.json"
+	"nonbonded.forcefield.json",
+	"tabulate.forcefield.json"
 ]
 
 
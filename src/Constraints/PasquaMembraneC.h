@@ -37,7 +37,7 @@ namespace SAPHRON
 			{
 				auto pi = _world->SelectParticle(i);
 				double neq = 0., npol = 0.;
-				for(auto& pj : pi->GetNeighbors())
+				for(auto* pj : pi->GetNeighbors())
 				{
 					Position rij = pi->GetPosition() - pj->GetPosition();
 					auto r = fnorm(rij);
@@ -47,15 +47,26 @@ namespace SAPHRON
 									 const Particle& p2,
 									 const Position& rij,
 									 unsigned int wid) const override
+		{
+			return EvaluatePair(p1, p2, rij, fdot(rij, rij), wid);
+		}
+
+		// Evaluates a pair given its squared distance. Not virtual so 
+		// pair kernels can inline it.
+		inline Interaction EvaluatePair(const Particle& p1,
+										const Particle& p2,
+										const Position&,
+										double rsq, 
+										unsigned int wid) const
 		{
 			Interaction ep;
 
-			auto r = fnorm(rij);
+			auto r = sqrt(rsq);
 
 			if (r > _rc[wid])
 				return ep;
 
-			auto rsq = r*r;
+			rsq = r*r;
 			auto q1 = p1.GetCharge();
 			auto q2 = p2.GetCharge();
 			auto erfcar = erfc(_alpha*r);
@@ -71,6 +82,9 @@ namespace SAPHRON
 			return ep;
 		}
 
+		// Get cutoff radii.
+		virtual const CutoffList& GetCutoffs() const override { return _rc; }
+
 		// Serialize DSF.
 		virtual void Serialize(Json::Value& json) const override
 		{
@@ -46,6 +46,9 @@ namespace SAPHRON
 			return ep;
 		}
 
+		// Get cutoff radii.
+		virtual const CutoffList& GetCutoffs() const override { return _rc; }
+
 		// Serialize DebyeHuckel.
 		virtual void Serialize(Json::Value& json) const override
 		{
@@ -5,6 +5,7 @@
 #include "../Simulation/SimInfo.h" 
 #include "../Worlds/World.h"
 #include <cmath>
+#include <vector>
 
 namespace SAPHRON 
 {
@@ -15,10 +16,253 @@ namespace SAPHRON
 		double _kmaxx, _kmaxy, _kmaxz;
 		CutoffList _rc; 
 		double _qdim;
+		double _tolerance;
+
+		// Cached reciprocal space of a world.
+		struct KSpace
+		{
+			// Box and charge log sequence number S(k) is up to date with.
+			bool valid = false;
+			double lx = 0, ly = 0, lz = 0;
+			unsigned long seq = 0;
+
+			// Wave vector indices in one half of k-space and their weights, 
+			// doubled if -k is summed too since |S(-k)| = |S(k)|.
+			std::vector<int> kx, ky, kz;
+			std::vector<double> ak;
+
+			// Structure factor S(k) and scratch of the same size.
+			std::vector<double> re, im, dre, dim;
+
+			// Sum of squared charges.
+			double qsq = 0;
+
+			// Phase tables exp(2*pi*i*m*x/L), m = 0..mx, along each axis 
+			// (cosine, sine). One row per charged primitive during rebuilds, 
+			// the first row is scratch for single primitive updates.
+			int mx = 0, my = 0, mz = 0;
+			std::vector<double> cx, sx, cy, sy, cz, sz;
+		};
+
+		// Reciprocal space of each world.
+		mutable std::vector<KSpace> _kspace;
+
+		// Fills c[m] + i*s[m] = exp(2*pi*i*m*t) for m = 0..n by recurrence.
+		static inline void FillPhases(double t, int n, double* c, double* s)
+		{
+			c[0] = 1.;
+			s[0] = 0.;
+			if(n == 0)
+				return;
+
+			c[1] = std::cos(2.*M_PI*t);
+			s[1] = std::sin(2.*M_PI*t);
+			for(int m = 2; m <= n; ++m)
+			{
+				c[m] = c[m-1]*c[1] - s[m-1]*s[1];
+				s[m] = s[m-1]*c[1] + c[m-1]*s[1];
+			}
+		}
+
+		// Gets exp(2*pi*i*k.r) for wave vector k from phase tables of a 
+		// primitive. Negative indices are complex conjugates.
+		static inline void Phase(int kx, int ky, int kz, 
+		                         const double* cx, const double* sx, 
+		                         const double* cy, const double* sy, 
+		                         const double* cz, const double* sz, 
+		                         double& re, double& im)
+		{
+			auto ax = std::abs(kx), ay = std::abs(ky), az = std::abs(kz);
+			double xr = cx[ax], xi = (kx < 0) ? -sx[ax] : sx[ax];
+			double yr = cy[ay], yi = (ky < 0) ? -sy[ay] : sy[ay];
+			double zr = cz[az], zi = (kz < 0) ? -sz[az] : sz[az];
+			double xyr = xr*yr - xi*yi;
+			double xyi = xr*yi + xi*yr;
+			re = xyr*zr - xyi*zi;
+			im = xyr*zi + xyi*zr;
+		}
+
+		// Adds q*exp(2*pi*i*k.r) to re, im for each wave vector.
+		static void AddCharge(KSpace& ks, double q, double x, double y, double z, 
+		                      std::vector<double>& re, std::vector<double>& im)
+		{
+			FillPhases(x/ks.lx, ks.mx, &ks.cx[0], &ks.sx[0]);
+			FillPhases(y/ks.ly, ks.my, &ks.cy[0], &ks.sy[0]);
+			FillPhases(z/ks.lz, ks.mz, &ks.cz[0], &ks.sz[0]);
+
+			for(size_t k = 0; k < ks.ak.size(); ++k)
+			{
+				double pr, pi;
+				Phase(ks.kx[k], ks.ky[k], ks.kz[k], &ks.cx[0], &ks.sx[0], 
+				      &ks.cy[0], &ks.sy[0], &ks.cz[0], &ks.sz[0], pr, pi);
+				re[k] += q*pr;
+				im[k] += q*pi;
+			}
+		}
+
+		// Adds the structure factor of the primitives of a particle displaced 
+		// by dr to re, im and their squared charges to qsq.
+		static void AddParticle(KSpace& ks, const Particle& particle, const Position& dr, double sign, 
+		                        std::vector<double>& re, std::vector<double>& im, double& qsq)
+		{
+			if(particle.HasChildren())
+			{
+				for(auto& child : particle)
+					AddParticle(ks, *child, dr, sign, re, im, qsq);
+				return;
+			}
+
+			auto q = particle.GetCharge();
+			if(q == 0)
+				return;
+
+			auto& x = particle.GetPosition();
+			AddCharge(ks, sign*q, x[0] + dr[0], x[1] + dr[1], x[2] + dr[2], re, im);
+			qsq += q*q;
+		}
+
+		// Rebuilds wave vectors and structure factor of a world.
+		void Rebuild(const World& w, KSpace& ks) const
+		{
+			auto& H = w.GetHMatrix();
+			ks.lx = H(0,0);
+			ks.ly = H(1,1);
+			ks.lz = H(2,2);
+
+			ks.kx.clear();
+			ks.ky.clear();
+			ks.kz.clear();
+			ks.ak.clear();
+
+			// Wave vector components span [-kmax, kmax).
+			auto inrange = [](int k, double kmax) { return k >= (int)-kmax && k < kmax; };
+
+			double coeff = 0.5/(M_PI*w.GetVolume());
+			double knormsq = _kmaxx*_kmaxx + _kmaxy*_kmaxy + _kmaxz*_kmaxz;
+			for(int kx = -_kmaxx; kx < _kmaxx; ++kx)
+				for(int ky = -_kmaxy; ky < _kmaxy; ++ky)
+					for(int kz = -_kmaxz; kz < _kmaxz; ++kz)
+					{
+						if(kx == 0 && ky == 0 && kz == 0)
+							continue; 
+			
+						double ksq = kx*kx + ky*ky + kz*kz;
+						if(ksq > knormsq + 2)
+							continue;
+
+						// Keep one of k and -k, weighting it twice.
+						bool upper = kx > 0 || (kx == 0 && (ky > 0 || (ky == 0 && kz > 0)));
+						bool paired = inrange(-kx, _kmaxx) && inrange(-ky, _kmaxy) && inrange(-kz, _kmaxz);
+						if(!upper && paired)
+							continue;
+
+						double hx = kx/ks.lx;
+						double hy = ky/ks.ly; 
+						double hz = kz/ks.lz;
+						double hsq = hx*hx + hy*hy + hz*hz;
+
+						ks.kx.push_back(kx);
+						ks.ky.push_back(ky);
+						ks.kz.push_back(kz);
+						ks.ak.push_back((paired ? 2. : 1.)*coeff/hsq*std::exp(-M_PI*M_PI*hsq/(_alpha*_alpha)));
+					}
+
+			ks.mx = (int)std::ceil(_kmaxx);
+			ks.my = (int)std::ceil(_kmaxy);
+			ks.mz = (int)std::ceil(_kmaxz);
+
+			// Phase tables of charged primitives.
+			auto& soa = w.GetPrimitiveArrays();
+			std::vector<int> charged;
+			ks.qsq = 0;
+			for(int i = 0; i < w.GetPrimitiveCount(); ++i)
+				if(soa.q[i] != 0)
+				{
+					charged.push_back(i);
+					ks.qsq += soa.q[i]*soa.q[i];
+				}
+
+			int n = charged.size();
+			int nx = ks.mx + 1, ny = ks.my + 1, nz = ks.mz + 1;
+			ks.cx.resize(n*nx + nx);
+			ks.sx.resize(n*nx + nx);
+			ks.cy.resize(n*ny + ny);
+			ks.sy.resize(n*ny + ny);
+			ks.cz.resize(n*nz + nz);
+			ks.sz.resize(n*nz + nz);
+
+			#pragma omp parallel for schedule(static)
+			for(int j = 0; j < n; ++j)
+			{
+				auto i = charged[j];
+				FillPhases(soa.x[i]/ks.lx, ks.mx, &ks.cx[j*nx], &ks.sx[j*nx]);
+				FillPhases(soa.y[i]/ks.ly, ks.my, &ks.cy[j*ny], &ks.sy[j*ny]);
+				FillPhases(soa.z[i]/ks.lz, ks.mz, &ks.cz[j*nz], &ks.sz[j*nz]);
+			}
+
+			// Sum over primitives for each wave vector.
+			int nk = ks.ak.size();
+			ks.re.assign(nk, 0);
+			ks.im.assign(nk, 0);
+
+			#pragma omp parallel for schedule(static)
+			for(int k = 0; k < nk; ++k)
+			{
+				double re = 0, im = 0;
+				for(int j = 0; j < n; ++j)
+				{
+					double pr, pi;
+					Phase(ks.kx[k], ks.ky[k], ks.kz[k], &ks.cx[j*nx], &ks.sx[j*nx], 
+					      &ks.cy[j*ny], &ks.sy[j*ny], &ks.cz[j*nz], &ks.sz[j*nz], pr, pi);
+					auto q = soa.q[charged[j]];
+					re += q*pr;
+					im += q*pi;
+				}
+				ks.re[k] = re;
+				ks.im[k] = im;
+			}
+
+			ks.seq = w.GetChargeLogStart() + w.GetChargeLog().size();
+			ks.valid = true;
+		}
+
+		// Gets the reciprocal space of a world, replaying logged charge 
+		// changes. It is rebuilt if the box changed or the log was dropped.
+		KSpace& Sync(const World& w) const
+		{
+			auto wid = w.GetID();
+			if((int)_kspace.size() <= wid)
+				_kspace.resize(wid + 1);
+
+			auto& ks = _kspace[wid];
+			w.TrackChargeChanges();
+
+			auto& H = w.GetHMatrix();
+			auto& log = w.GetChargeLog();
+			auto start = w.GetChargeLogStart();
+			if(!ks.valid || ks.seq < start || 
+			   ks.lx != H(0,0) || ks.ly != H(1,1) || ks.lz != H(2,2))
+			{
+				Rebuild(w, ks);
+				return ks;
+			}
+
+			for(auto k = ks.seq - start; k < log.size(); ++k)
+			{
+				auto& c = log[k];
+				AddCharge(ks, -c.qold, c.rold[0], c.rold[1], c.rold[2], ks.re, ks.im);
+				AddCharge(ks, c.qnew, c.rnew[0], c.rnew[1], c.rnew[2], ks.re, ks.im);
+				ks.qsq += c.qnew*c.qnew - c.qold*c.qold;
+			}
+			ks.seq = start + log.size();
+
+			return ks;
+		}
 
 	public:
 		EwaldFF(double alpha, double kmaxx, double kmaxy, double kmaxz, const CutoffList& rc) : 
-		_alpha(alpha), _kmaxx(kmaxx), _kmaxy(kmaxy), _kmaxz(kmaxz), _rc(rc)
+		_alpha(alpha), _kmaxx(kmaxx), _kmaxy(kmaxy), _kmaxz(kmaxz), _rc(rc), 
+		_qdim(0), _tolerance(0)
 		{
 			auto& sim = SimInfo::Instance(); 
 			_qdim = sim.GetChargeConv();         
@@ -28,9 +272,20 @@ namespace SAPHRON
 							const Particle& p2,
 							const Position& rij,
 							unsigned int wid) const override
+		{
+			return EvaluatePair(p1, p2, rij, fdot(rij, rij), wid);
+		}
+
+		// Evaluates a pair given its squared distance. Not virtual so 
+		// pair kernels can inline it.
+		inline Interaction EvaluatePair(const Particle& p1,
+										const Particle& p2,
+										const Position&,
+										double rsq, 
+										unsigned int wid) const
 		{
 			Interaction ep; 
-			auto r = fnorm(rij); 
+			auto r = sqrt(rsq); 
 
 			if(r > _rc[wid])
 				return ep;
@@ -48,52 +303,92 @@ namespace SAPHRON
 
 		double ReciprocalSpace(const World& w) const override
 		{
+			auto& ks = Sync(w);
+
 			double u = 0;
-			auto& H = w.GetHMatrix();
+			for(size_t k = 0; k < ks.ak.size(); ++k)
+				u += ks.ak[k]*(ks.re[k]*ks.re[k] + ks.im[k]*ks.im[k]);
+			u -= _alpha/std::sqrt(M_PI)*ks.qsq;
 
-			for(int i = 0; i < w.GetPrimitiveCount(); ++i)
-			{
-				auto p = w.SelectPrimitive(i);
-				auto q = p->GetCharge();
-				u -= _alpha/std::sqrt(M_PI)*q*q;
-			}
+			return _qdim*u;
+		}
 
-			double coeff = 0.5/(M_PI*w.GetVolume());
-			double knormsq = _kmaxx*_kmaxx + _kmaxy*_kmaxy + _kmaxz*_kmaxz;
-			for(int kx = -_kmaxx; kx < _kmaxx; ++kx)
-				for(int ky = -_kmaxy; ky < _kmaxy; ++ky)
-					for(int kz = -_kmaxz; kz < _kmaxz; ++kz)
-					{
-						if(kx == 0 && ky == 0 && kz == 0)
-							continue; 
-			
-						double ksq = kx*kx + ky*ky + kz*kz;
-						if(ksq > knormsq + 2)
-							continue;
+		// Share of a particle in the reciprocal space energy, i.e. the 
+		// energy removed along with it including its self term.
+		double ReciprocalSpace(const Particle& particle) const override
+		{
+			auto* w = particle.GetWorld();
+			if(w == nullptr)
+				return 0;
 
-						double hx = kx/H(0,0);
-						double hy = ky/H(1,1); 
-						double hz = kz/H(2,2);
-						double hsq = hx*hx + hy*hy + hz*hz;
+			auto& ks = Sync(*w);
+			auto nk = ks.ak.size();
+			ks.dre.assign(nk, 0);
+			ks.dim.assign(nk, 0);
+
+			double qsq = 0;
+			AddParticle(ks, particle, {0, 0, 0}, 1., ks.dre, ks.dim, qsq);
+			if(qsq == 0)
+				return 0;
+
+			double u = 0;
+			for(size_t k = 0; k < nk; ++k)
+				u += ks.ak[k]*(2.*(ks.dre[k]*ks.re[k] + ks.dim[k]*ks.im[k]) - 
+				               ks.dre[k]*ks.dre[k] - ks.dim[k]*ks.dim[k]);
+			u -= _alpha/std::sqrt(M_PI)*qsq;
+
+			return _qdim*u;
+		}
+
+		// Change in reciprocal space energy if a particle is displaced by dr.
+		double ReciprocalDelta(const Particle& particle, const Position& dr) const override
+		{
+			auto* w = particle.GetWorld();
+			if(w == nullptr)
+				return 0;
+
+			auto& ks = Sync(*w);
+			auto nk = ks.ak.size();
+			ks.dre.assign(nk, 0);
+			ks.dim.assign(nk, 0);
+
+			double qsq = 0;
+			AddParticle(ks, particle, dr, 1., ks.dre, ks.dim, qsq);
+			AddParticle(ks, particle, {0, 0, 0}, -1., ks.dre, ks.dim, qsq);
+			if(qsq == 0)
+				return 0;
+
+			double u = 0;
+			for(size_t k = 0; k < nk; ++k)
+				u += ks.ak[k]*(2.*(ks.dre[k]*ks.re[k] + ks.dim[k]*ks.im[k]) + 
+				               ks.dre[k]*ks.dre[k] + ks.dim[k]*ks.dim[k]);
 
-						double csum = 0, ssum = 0;
-						for(int i = 0; i < w.GetPrimitiveCount(); ++i)
-						{
-							auto p = w.SelectPrimitive(i);
-							auto q = p->GetCharge();
-							auto& x = p->GetPosition();
-							csum += q*std::cos(2.*M_PI*(x[0]*hx + x[1]*hy + x[2]*hz));
-							ssum += q*std::sin(2.*M_PI*(x[0]*hx + x[1]*hy + x[2]*hz));
-						}
-						u += coeff/hsq*std::exp(-M_PI*M_PI*hsq/(_alpha*_alpha))*(csum*csum + ssum*ssum);
-					}
 			return _qdim*u;
 		}
 
+		// Get cutoff radii.
+		virtual const CutoffList& GetCutoffs() const override { return _rc; }
+
+		// Get relative error the parameters were tuned for, zero if 
+		// they were given explicitly.
+		double GetTolerance() const { return _tolerance; }
 
+		// Set relative error the parameters were tuned for.
+		void SetTolerance(double tolerance) { _tolerance = tolerance; }
+
+		double GetAlpha() const { return _alpha; }
+
+		// Serialize Ewald. Tuned parameters are written out explicitly so 
+		// the same parameters are used when reloaded.
 		void Serialize(Json::Value& json) const override
 		{
-
+			json["type"] = "Ewald";
+			json["alpha"] = _alpha;
+			json["kmax"].append((int)_kmaxx);
+			json["kmax"].append((int)_kmaxy);
+			json["kmax"].append((int)_kmaxz);
+			for(auto& rc : _rc)
+				json["rcut"].append(rc);
 		}
 	};
 }
\ No newline at end of file
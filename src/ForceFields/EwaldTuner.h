@@ -0,0 +1,285 @@
+#pragma once
+
+#include "EwaldFF.h"
+#include "../Simulation/SimException.h"
+#include "../Worlds/World.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace SAPHRON
+{
+	// Ewald parameters selected by EwaldTuner.
+	struct EwaldParameters
+	{
+		double alpha;
+		int kmaxx, kmaxy, kmaxz;
+
+		// Real space cutoff of each world by world ID.
+		CutoffList rc;
+
+		// Estimated relative error.
+		double error;
+	};
+
+	// Selects Ewald parameters for a relative energy error. For each world,
+	// the real space and reciprocal space errors are estimated following
+	// Kolafa and Perram, Mol. Simul. 9, 351 (1992), relative to sum(q^2)/a
+	// where a is the mean spacing between charges. Costs per pair and per
+	// charge and wave vector are measured on the worlds themselves. The
+	// splitting parameter alpha is then scanned, picking for each value the
+	// smallest cutoff and kmax meeting the tolerance, and the cheapest
+	// combination over all worlds is returned.
+	class EwaldTuner
+	{
+	private:
+		double _tol;
+
+		// Properties of a world relevant to tuning.
+		struct WorldInfo
+		{
+			int id;
+			int nq;
+			double spacing;
+			double volume;
+			double lx, ly, lz;
+
+			// Largest possible real space cutoff.
+			double rcmax;
+
+			// Measured cost per real space pair and per charge and wave vector (s).
+			double creal, crecip;
+		};
+
+		typedef std::chrono::steady_clock Clock;
+
+		// Approximate number of wave vectors summed for kmax.
+		static double WaveVectorCount(int kx, int ky, int kz)
+		{
+			return 2.*M_PI/3.*kx*ky*kz;
+		}
+
+		// Times evaluation of real space pairs between charged primitives.
+		static double ProbeRealSpace(const World& w, const std::vector<int>& charged, double alpha)
+		{
+			auto wid = w.GetID();
+			EwaldFF ewald(alpha, 1, 1, 1, CutoffList(wid + 1, std::numeric_limits<double>::max()));
+			auto n = std::min<int>(charged.size(), 64);
+
+			long pairs = 0;
+			double u = 0;
+			auto start = Clock::now();
+			while(pairs == 0 || Clock::now() - start < std::chrono::milliseconds(2))
+			{
+				for(int i = 0; i < n; ++i)
+				{
+					auto* p1 = w.SelectPrimitive(charged[i]);
+					for(int j = i + 1; j < n; ++j)
+					{
+						auto* p2 = w.SelectPrimitive(charged[j]);
+						Position rij = p1->GetPosition() - p2->GetPosition();
+						w.ApplyMinimumImage(&rij);
+						u += ewald.Evaluate(*p1, *p2, rij, wid).energy;
+						++pairs;
+					}
+				}
+				if(n < 2)
+					break;
+			}
+
+			// Keep the loop from being optimized away.
+			volatile double sink = u;
+			(void)sink;
+
+			return pairs ? std::chrono::duration<double>(Clock::now() - start).count()/pairs : 0;
+		}
+
+		// Times a full reciprocal space evaluation at a small kmax.
+		static double ProbeReciprocal(const World& w, int nq, double alpha)
+		{
+			const int kmax = 4;
+			auto wid = w.GetID();
+
+			int runs = 0;
+			auto start = Clock::now();
+			while(runs == 0 || Clock::now() - start < std::chrono::milliseconds(2))
+			{
+				EwaldFF ewald(alpha, kmax, kmax, kmax, CutoffList(wid + 1, 1.0));
+				ewald.ReciprocalSpace(w);
+				++runs;
+			}
+
+			auto t = std::chrono::duration<double>(Clock::now() - start).count()/runs;
+			return t/(nq*WaveVectorCount(kmax, kmax, kmax));
+		}
+
+		// Smallest cutoff meeting the real space error, or a negative
+		// value if rcmax does not.
+		static double SolveCutoff(const WorldInfo& wi, double alpha, double tol)
+		{
+			if(RealSpaceError(alpha, wi.rcmax, wi.volume, wi.spacing) > tol)
+				return -1;
+
+			double lo = 1e-3*wi.rcmax, hi = wi.rcmax;
+			for(int i = 0; i < 60; ++i)
+			{
+				auto mid = 0.5*(lo + hi);
+				if(RealSpaceError(alpha, mid, wi.volume, wi.spacing) > tol)
+					lo = mid;
+				else
+					hi = mid;
+			}
+			return hi;
+		}
+
+		// Smallest kmax meeting the reciprocal space error along an axis,
+		// or a negative value if none up to a limit does.
+		static int SolveKmax(double alpha, double length, double spacing, double tol)
+		{
+			for(int k = 1; k <= 256; ++k)
+				if(ReciprocalError(alpha, k, length, spacing) <= tol)
+					return k;
+			return -1;
+		}
+
+	public:
+		EwaldTuner(double tolerance) : _tol(tolerance) {}
+
+		// Estimated real space energy error relative to sum(q^2)/spacing.
+		static double RealSpaceError(double alpha, double rc, double volume, double spacing)
+		{
+			auto arc = alpha*rc;
+			return spacing*std::sqrt(rc/(2.*volume))*std::exp(-arc*arc)/(arc*arc);
+		}
+
+		// Estimated reciprocal space energy error relative to sum(q^2)/spacing.
+		static double ReciprocalError(double alpha, int kmax, double length, double spacing)
+		{
+			auto x = M_PI*kmax/(alpha*length);
+			return spacing*alpha/(M_PI*M_PI)*std::pow(kmax, -1.5)*std::exp(-x*x);
+		}
+
+		// Selects parameters for the worlds. Throws BuildException if the
+		// tolerance cannot be met within the neighbor list radius.
+		EwaldParameters Tune(const WorldList& worlds) const
+		{
+			std::vector<WorldInfo> infos;
+			int maxid = 0;
+			for(auto* w : worlds)
+			{
+				maxid = std::max(maxid, w->GetID());
+
+				std::vector<int> charged;
+				for(int i = 0; i < w->GetPrimitiveCount(); ++i)
+					if(w->SelectPrimitive(i)->GetCharge() != 0)
+						charged.push_back(i);
+				if(charged.empty())
+					continue;
+
+				auto& H = w->GetHMatrix();
+				WorldInfo wi;
+				wi.id = w->GetID();
+				wi.nq = charged.size();
+				wi.volume = w->GetVolume();
+				wi.spacing = std::cbrt(wi.volume/wi.nq);
+				wi.lx = H(0,0);
+				wi.ly = H(1,1);
+				wi.lz = H(2,2);
+				wi.rcmax = 0.5*std::min({wi.lx, wi.ly, wi.lz});
+				if(w->GetNeighborRadius() > 0)
+					wi.rcmax = std::min(wi.rcmax, w->GetNeighborRadius() - w->GetSkinThickness());
+
+				// Probe at a typical splitting parameter.
+				auto alpha = 5./std::min({wi.lx, wi.ly, wi.lz});
+				wi.creal = ProbeRealSpace(*w, charged, alpha);
+				wi.crecip = ProbeReciprocal(*w, wi.nq, alpha);
+				infos.push_back(wi);
+			}
+
+			if(infos.empty())
+				throw BuildException({"Ewald tuning requires charged particles."});
+
+			double lmin = std::numeric_limits<double>::max();
+			for(auto& wi : infos)
+				lmin = std::min({lmin, wi.lx, wi.ly, wi.lz});
+
+			// Real and reciprocal space errors are independent.
+			auto tol = _tol/std::sqrt(2.);
+
+			EwaldParameters best{0, 0, 0, 0, CutoffList(), 0};
+			double bestcost = std::numeric_limits<double>::max();
+
+			// Scan alpha*L over [1, 100].
+			const int steps = 400;
+			for(int s = 0; s <= steps; ++s)
+			{
+				auto alpha = std::pow(100., (double)s/steps)/lmin;
+
+				int kx = 0, ky = 0, kz = 0;
+				std::vector<double> rc;
+				bool feasible = true;
+				for(auto& wi : infos)
+				{
+					auto r = SolveCutoff(wi, alpha, tol);
+					auto x = SolveKmax(alpha, wi.lx, wi.spacing, tol);
+					auto y = SolveKmax(alpha, wi.ly, wi.spacing, tol);
+					auto z = SolveKmax(alpha, wi.lz, wi.spacing, tol);
+					if(r < 0 || x < 0 || y < 0 || z < 0)
+					{
+						feasible = false;
+						break;
+					}
+					rc.push_back(r);
+					kx = std::max(kx, x);
+					ky = std::max(ky, y);
+					kz = std::max(kz, z);
+				}
+
+				if(!feasible)
+					continue;
+
+				double cost = 0;
+				for(size_t i = 0; i < infos.size(); ++i)
+				{
+					auto& wi = infos[i];
+					auto pairs = 0.5*wi.nq*(wi.nq/wi.volume)*4./3.*M_PI*std::pow(rc[i], 3);
+					cost += wi.creal*pairs + wi.crecip*wi.nq*WaveVectorCount(kx, ky, kz);
+				}
+
+				if(cost < bestcost)
+				{
+					bestcost = cost;
+					best.alpha = alpha;
+					best.kmaxx = kx;
+					best.kmaxy = ky;
+					best.kmaxz = kz;
+					best.rc.assign(maxid + 1, 0);
+					best.error = 0;
+					for(size_t i = 0; i < infos.size(); ++i)
+					{
+						auto& wi = infos[i];
+						best.rc[wi.id] = rc[i];
+						auto er = RealSpaceError(alpha, rc[i], wi.volume, wi.spacing);
+						auto ek = std::max({ReciprocalError(alpha, kx, wi.lx, wi.spacing),
+						                    ReciprocalError(alpha, ky, wi.ly, wi.spacing),
+						                    ReciprocalError(alpha, kz, wi.lz, wi.spacing)});
+						best.error = std::max(best.error, std::sqrt(er*er + ek*ek));
+					}
+				}
+			}
+
+			if(bestcost == std::numeric_limits<double>::max())
+				throw BuildException({"Ewald tolerance cannot be met within the neighbor list radius."});
+
+			// Worlds without charges use the largest cutoff.
+			auto rcmax = *std::max_element(best.rc.begin(), best.rc.end());
+			for(auto& r : best.rc)
+				if(r == 0)
+					r = rcmax;
+
+			return best;
+		}
+	};
+}
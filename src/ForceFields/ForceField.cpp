@@ -15,11 +15,58 @@
 #include "LebwohlLasherFF.h"
 #include "ModLennardJonesTSFF.h"
 #include "EwaldFF.h"
+#include "EwaldTuner.h"
+#include "SPMEFF.h"
+#include "TabulatedFF.h"
 
 using namespace Json;
 
 namespace SAPHRON
 {
+	// Wraps a forcefield in a TabulatedFF if requested. Probe particles 
+	// of the given species with unit charges are used for sampling. 
+	// Takes ownership of ff.
+	static ForceField* Tabulate(ForceField* ff, 
+								const Value& json,
+								const std::string& p1type,
+								const std::string& p2type,
+								bool charged, 
+								const std::string& path)
+	{
+		if(!json.isMember("tabulate"))
+			return ff;
+
+		auto& tab = json["tabulate"];
+		auto points = tab["points"].asInt();
+		auto rmin = tab.get("rmin", 0).asDouble();
+		auto rmax = tab.get("rmax", 0).asDouble();
+
+		// Determine smallest table range.
+		auto& rc = ff->GetCutoffs();
+		auto hi = rc.size() ? *std::min_element(rc.begin(), rc.end()) : rmax;
+		if(rmax > 0)
+			hi = std::min(hi, rmax);
+
+		if(hi <= 0)
+		{
+			delete ff;
+			throw BuildException({path + ": Tabulating a forcefield without a cutoff requires \"rmax\"."});
+		}
+
+		if(rmin >= hi)
+		{
+			delete ff;
+			throw BuildException({path + ": Tabulation \"rmin\" must be smaller than the cutoff and \"rmax\"."});
+		}
+
+		Particle p1({0, 0, 0}, {0, 0, 1}, p1type);
+		Particle p2({0, 0, 0}, {0, 0, 1}, p2type);
+		p1.SetCharge(1.0);
+		p2.SetCharge(1.0);
+
+		return new TabulatedFF(ff, p1, p2, points, charged, rmin, rmax);
+	}
+
 	ForceField* ForceField::BuildElectrostatic(const Value &json, 
 											   ForceFieldManager *ffm)
 	{
@@ -29,6 +76,14 @@ namespace SAPHRON
 	ForceField* ForceField::BuildElectrostatic(const Value &json, 
 											   ForceFieldManager *ffm, 
 											   const std::string &path)
+	{
+		return BuildElectrostatic(json, ffm, path, WorldList());
+	}
+
+	ForceField* ForceField::BuildElectrostatic(const Value &json, 
+											   ForceFieldManager *ffm, 
+											   const std::string &path, 
+											   const WorldList& worlds)
 	{
 		ObjectRequirement validator; 
 		Value schema;
@@ -61,21 +116,75 @@ namespace SAPHRON
 			reader.parse(JsonSchema::EwaldFF, schema);
 			validator.Parse(schema, path);
 
+			// Validate inputs. 
+			validator.Validate(json, path);
+			if(validator.HasErrors())
+				throw BuildException(validator.GetErrors());
+
+			if(json.isMember("tolerance"))
+			{
+				if(worlds.size() == 0)
+					throw BuildException({path + ": Worlds must be defined before tuning Ewald parameters."});
+
+				// Tune alpha, kmax and cutoffs.
+				auto tol = json["tolerance"].asDouble();
+				EwaldParameters p; 
+				try{
+					p = EwaldTuner(tol).Tune(worlds);
+				} catch(BuildException& e) {
+					throw BuildException({path + ": " + e.GetErrors()[0]});
+				}
+
+				auto* ewald = new EwaldFF(p.alpha, p.kmaxx, p.kmaxy, p.kmaxz, p.rc);
+				ewald->SetTolerance(tol);
+				ff = ewald;
+			}
+			else
+			{
+				if(!json.isMember("alpha") || !json.isMember("kmax") || !json.isMember("rcut"))
+					throw BuildException({path + ": Either \"tolerance\" or \"alpha\", \"kmax\" and \"rcut\" must be specified."});
+
+				double alpha = json["alpha"].asDouble();
+				double kmaxx = json["kmax"][0].asInt();
+				double kmaxy = json["kmax"][1].asInt();
+				double kmaxz = json["kmax"][2].asInt();
+
+				CutoffList rc;
+				for(auto r : json["rcut"])
+					rc.push_back(r.asDouble());
+				
+				ff = new EwaldFF(alpha, kmaxx, kmaxy, kmaxz, rc);
+			}
+		}
+		else if(type == "SPME")
+		{
+			reader.parse(JsonSchema::SPMEFF, schema);
+			validator.Parse(schema, path);
+
 			// Validate inputs. 
 			validator.Validate(json, path);
 			if(validator.HasErrors())
 				throw BuildException(validator.GetErrors());
 
 			double alpha = json["alpha"].asDouble();
-			double kmaxx = json["kmax"][0].asInt();
-			double kmaxy = json["kmax"][1].asInt();
-			double kmaxz = json["kmax"][2].asInt();
+			int kx = json["grid"][0].asInt();
+			int ky = json["grid"][1].asInt();
+			int kz = json["grid"][2].asInt();
+			int order = json.get("order", 4).asInt();
+			double slab = json.get("slab_factor", 3.).asDouble();
+
+			if(kx < order || ky < order || kz < order)
+				throw BuildException({path + ": SPME grid must be at least as large as the spline order."});
+
+			for(auto* w : worlds)
+				if(!SPMEFF::IsSupported(*w))
+					throw BuildException({path + ": SPME supports at most one non-periodic axis."});
 
 			CutoffList rc;
 			for(auto r : json["rcut"])
 				rc.push_back(r.asDouble());
 			
-			ff = new EwaldFF(alpha, kmaxx, kmaxy, kmaxz, rc);
+			ff = new SPMEFF(alpha, kx, ky, kz, order, rc, slab);
 		}
 		else if(type == "DebyeHuckel")
 		{
@@ -102,6 +211,21 @@ namespace SAPHRON
 			throw BuildException({path + ": Unknown electrostatic forcefield type specified."});
 		}
 
+		// Tabulate using any existing species. Electrostatic forcefields only
+		// depend on charges, which are set to one on the probes and scaled by
+		// q1*q2 on evaluation, so the probe species does not matter.
+		if(json.isMember("tabulate"))
+		{
+			auto& species = Particle::GetSpeciesList();
+			if(species.size() == 0)
+			{
+				delete ff;
+				throw BuildException({path + ": Particles must be defined before tabulating electrostatics."});
+			}
+
+			ff = Tabulate(ff, json, species[0], species[0], true, path);
+		}
+
 		// Add to appropriate species pair.
 		try{
 			ffm->SetElectrostaticForcefield(*ff);
@@ -280,6 +404,8 @@ namespace SAPHRON
 			throw BuildException({path + ": Unknown forcefield type specified."});
 		}
 
+		ff = Tabulate(ff, json, json["species"][0].asString(), json["species"][1].asString(), false, path);
+
 		// Add to appropriate species pair.
 		try{
 			std::string p1type = json["species"][0].asString();
@@ -350,6 +476,8 @@ namespace SAPHRON
 			throw BuildException({path + ": Unknown forcefield type specified."});
 		}
 
+		ff = Tabulate(ff, json, json["species"][0].asString(), json["species"][1].asString(), false, path);
+
 		// Add to appropriate species pair.
 		try{
 			std::string p1type = json["species"][0].asString();
@@ -368,6 +496,14 @@ namespace SAPHRON
 	void ForceField::BuildForceFields(const Value& json, 
 									  ForceFieldManager* ffm, 
 									  FFList& fflist)
+	{
+		BuildForceFields(json, ffm, fflist, WorldList());
+	}
+
+	void ForceField::BuildForceFields(const Value& json, 
+									  ForceFieldManager* ffm, 
+									  FFList& fflist, 
+									  const WorldList& worlds)
 	{
 		ObjectRequirement validator;
 		Value schema;
@@ -394,7 +530,7 @@ namespace SAPHRON
 		// Set electrostatic.
 		if(json.isMember("electrostatic"))
 			fflist.push_back(
-				BuildElectrostatic(json["electrostatic"], ffm, "#forcefields/electrostatic")
+				BuildElectrostatic(json["electrostatic"], ffm, "#forcefields/electrostatic", worlds)
 				);
 
 		// Loop through bonded.
@@ -406,5 +542,16 @@ namespace SAPHRON
 				);
 			++i;
 		}
+
+		// Particle energy cache.
+		if(json.isMember("energy_cache"))
+			ffm->SetEnergyCache(json["energy_cache"].asBool());
+
+		// Scaling of 1-2, 1-3 and 1-4 intramolecular interactions.
+		if(json.isMember("intra_scaling"))
+		{
+			auto& scale = json["intra_scaling"];
+			ffm->SetIntraScaling(scale[0].asDouble(), scale[1].asDouble(), scale[2].asDouble());
+		}
 	}
 }
\ No newline at end of file
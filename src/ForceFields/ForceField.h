@@ -11,10 +11,12 @@ namespace SAPHRON
 	// Forward delcare.
 	class ForceFieldManager;
 	class ForceField;
+	class World;
 
 	// Typedefs. 
 	using FFList = std::vector<ForceField*>;
 	using CutoffList = std::vector<double>;
+	using WorldList = std::vector<World*>;
 
 	// Abstract base class for a force field. Represents the scalar interaction potential
 	// between two bodies (particles). It calculates energy and intermolecular virial 
@@ -47,6 +49,23 @@ namespace SAPHRON
 		// if it exists.
 		virtual double ReciprocalSpace(const World&) const { return 0.0; }
 
+		// Evaluates the share of a particle in the reciprocal space 
+		// contribution, such that changing or removing the particle 
+		// changes the contribution by the change in its share.
+		virtual double ReciprocalSpace(const Particle&) const { return 0.0; }
+
+		// Evaluates the change in the reciprocal space contribution if 
+		// a particle (and its children) were displaced by dr.
+		virtual double ReciprocalDelta(const Particle&, const Position&) const { return 0.0; }
+
+		// Gets the cutoff radius for each world. The forcefield must 
+		// vanish beyond it. An empty list means no cutoff.
+		virtual const CutoffList& GetCutoffs() const 
+		{ 
+			static const CutoffList none;
+			return none; 
+		}
+
 		// Serialize 
 		virtual void Serialize(Json::Value& json) const override = 0;
 
@@ -83,6 +102,13 @@ namespace SAPHRON
 										 	  ForceFieldManager* ffm, 
 										  	  const std::string& path);
 
+		// Overloaded function providing the worlds, which are needed to tune 
+		// Ewald parameters to a "tolerance".
+		static ForceField* BuildElectrostatic(const Json::Value& json, 
+										 	  ForceFieldManager* ffm, 
+										  	  const std::string& path, 
+										  	  const WorldList& worlds);
+
 		// Builds forcefields from base tree root["forcefields"] and adds them to the
 		// Forcefield manager. It also adds all initialized pointers to the fflist array 
 		// passed in. Throws exception on failure. Object lifetime management is caller's 
@@ -91,6 +117,12 @@ namespace SAPHRON
 									 ForceFieldManager* ffm, 
 									 FFList& fflist);
 
+		// Overloaded function providing the worlds the forcefields are used in.
+		static void BuildForceFields(const Json::Value& json, 
+									 ForceFieldManager* ffm, 
+									 FFList& fflist, 
+									 const WorldList& worlds);
+
 		virtual ~ForceField() {}
 	};
 }
@@ -1,13 +1,34 @@
 #include "ForceFieldManager.h"
 #include "../Constraints/Constraint.h"
+#include "PairKernels.h"
+#include "LennardJonesFF.h"
+#include "LennardJonesTSFF.h"
+#include "LebwohlLasherFF.h"
+#include "LennardJonesBatch.h"
+#include "DSFFF.h"
+#include "EwaldFF.h"
+#include "SPMEFF.h"
+#include "TabulatedFF.h"
+#include "../Utils/Profiler.h"
+#include "../Utils/Threads.h"
 #include "config.h"
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <iostream>
 #include <utility>
 #include <stdexcept>
+#include <typeinfo>
+#include <vector>
 
 namespace SAPHRON
 {
+	// Profiler sections.
+	static const ProfileHandle ProfileInter = Profiler::Instance().Register("e_inter");
+	static const ProfileHandle ProfileIntra = Profiler::Instance().Register("e_intra");
+
+	unsigned long ForceFieldManager::_nextkey = 0;
+
 	// Adds a forcefield to the manager.
 	void ForceFieldManager::AddNonBondedForceField(std::string p1type, std::string p2type, ForceField& ff)
 	{
@@ -32,6 +53,8 @@ namespace SAPHRON
 		if(_uniquenbffs.find({p1type, p2type}) == _uniquenbffs.end() && 
 			_uniquenbffs.find({p2type, p1type}) == _uniquenbffs.end())
 			_uniquenbffs.insert(std::pair<SpeciesPair, ForceField*>({p1type, p2type}, &ff));
+
+		BuildTables();
 	}
 
 	// Removes a forcefield from the manager.
@@ -53,6 +76,7 @@ namespace SAPHRON
 		_uniquenbffs.erase({p1type, p2type});
 		_uniquenbffs.erase({p2type, p1type});
 
+		BuildTables();
 	}
 
 	// Get the number of registered forcefields.
@@ -85,6 +109,8 @@ namespace SAPHRON
 		if(_uniquebffs.find({p1type, p2type}) == _uniquebffs.end() && 
 			_uniquebffs.find({p2type, p1type}) == _uniquebffs.end())
 			_uniquebffs.insert(std::pair<SpeciesPair, ForceField*>({p1type, p2type}, &ff));
+
+		BuildTables();
 	}
 
 	// Removes a forcefield from the manager.
@@ -107,6 +133,7 @@ namespace SAPHRON
 		_uniquebffs.erase({p1type, p2type});
 		_uniquebffs.erase({p2type, p1type});
 
+		BuildTables();
 	}
 
 	// Get the number of registered forcefields.
@@ -119,12 +146,138 @@ namespace SAPHRON
 	void ForceFieldManager::SetElectrostaticForcefield(const ForceField &ff)
 	{
 		_electroff = &ff;
+		BuildTables();
 	}
 
 	// Resets the electrostatic forcefield.
 	void ForceFieldManager::ResetElectrostaticForceField()
 	{
 		_electroff = nullptr;
+		BuildTables();
+	}
+
+	void ForceFieldManager::BuildTables()
+	{
+		// Cached energies are stale.
+		ResetEnergyCache();
+
+		// Size to all species currently registered.
+		auto n = (int)Particle::GetSpeciesList().size();
+		for(auto& it : _nonbondedforcefields)
+			n = std::max(n, std::max(it.first.first, it.first.second) + 1);
+		for(auto& it : _bondedforcefields)
+			n = std::max(n, std::max(it.first.first, it.first.second) + 1);
+
+		_nspecies = n;
+		_trials.resize(std::max((int)_trials.size(), GetMaxThreads()));
+		_nbtable.assign(n*n, nullptr);
+		_btable.assign(n*n, nullptr);
+
+		for(auto& it : _nonbondedforcefields)
+			_nbtable[it.first.first*n + it.first.second] = it.second;
+		for(auto& it : _bondedforcefields)
+			_btable[it.first.first*n + it.first.second] = it.second;
+
+		// Cutoffs are tabulated for every world any forcefield knows about.
+		size_t nworlds = (_electroff != nullptr) ? _electroff->GetCutoffs().size() : 0;
+		for(auto& it : _nonbondedforcefields)
+			nworlds = std::max(nworlds, it.second->GetCutoffs().size());
+
+		// Squared cutoff of a forcefield in a world. Slightly padded 
+		// so the table never skips a pair the forcefield would evaluate.
+		auto cutoffsq = [](const ForceField* ff, size_t wid) {
+			if(ff == nullptr)
+				return -1.;
+			auto& rc = ff->GetCutoffs();
+			if(wid >= rc.size())
+				return std::numeric_limits<double>::infinity();
+			return rc[wid]*rc[wid]*(1. + 1e-10);
+		};
+
+		_rcsqtable.assign(nworlds, std::vector<double>(n*n));
+		for(size_t wid = 0; wid < nworlds; ++wid)
+			for(int k = 0; k < n*n; ++k)
+				_rcsqtable[wid][k] = std::max(cutoffsq(_nbtable[k], wid), cutoffsq(_electroff, wid));
+
+		// Use a specialized pair kernel if all non-bonded forcefields 
+		// are of one supported type.
+		const std::type_info* type = nullptr;
+		for(auto& it : _nonbondedforcefields)
+		{
+			auto& t = typeid(*it.second);
+			if(type != nullptr && *type != t)
+			{
+				type = nullptr;
+				break;
+			}
+			type = &t;
+		}
+
+		if(type != nullptr && *type == typeid(LennardJonesFF))
+			SelectInterKernel<LennardJonesFF>("LennardJones");
+		else if(type != nullptr && *type == typeid(LennardJonesTSFF))
+			SelectInterKernel<LennardJonesTSFF>("LennardJonesTS");
+		else if(type != nullptr && *type == typeid(LebwohlLasherFF))
+			SelectInterKernel<LebwohlLasherFF>("LebwohlLasher");
+		else if(type != nullptr && *type == typeid(TabulatedFF))
+			SelectInterKernel<TabulatedFF>("Tabulated");
+		else
+			SelectInterKernel<ForceField>("Generic");
+
+		// Lennard-Jones without electrostatics is evaluated in batches.
+		if(_electroff == nullptr && type != nullptr && *type == typeid(LennardJonesFF))
+		{
+			_interkernel = &ForceFieldManager::EvaluateInterBatched<LennardJonesFF, true>;
+			_energykernel = &ForceFieldManager::EvaluateInterBatched<LennardJonesFF, false>;
+			_deltakernel = &ForceFieldManager::EvaluateDeltaBatched<LennardJonesFF>;
+		}
+		else if(_electroff == nullptr && type != nullptr && *type == typeid(LennardJonesTSFF))
+		{
+			_interkernel = &ForceFieldManager::EvaluateInterBatched<LennardJonesTSFF, true>;
+			_energykernel = &ForceFieldManager::EvaluateInterBatched<LennardJonesTSFF, false>;
+			_deltakernel = &ForceFieldManager::EvaluateDeltaBatched<LennardJonesTSFF>;
+		}
+	}
+
+	template<typename NB>
+	void ForceFieldManager::SelectInterKernel(const std::string& name)
+	{
+		_kernelname = name;
+		if(_electroff == nullptr)
+			SetInterKernels<NB, NoForceField>();
+		else if(typeid(*_electroff) == typeid(DSFFF))
+		{
+			SetInterKernels<NB, DSFFF>();
+			_kernelname += "+DSF";
+		}
+		else if(typeid(*_electroff) == typeid(EwaldFF))
+		{
+			SetInterKernels<NB, EwaldFF>();
+			_kernelname += "+Ewald";
+		}
+		else if(typeid(*_electroff) == typeid(SPMEFF))
+		{
+			SetInterKernels<NB, SPMEFF>();
+			_kernelname += "+SPME";
+		}
+		else if(typeid(*_electroff) == typeid(TabulatedFF))
+		{
+			SetInterKernels<NB, TabulatedFF>();
+			_kernelname += "+Tabulated";
+		}
+		else
+		{
+			SetInterKernels<NB, ForceField>();
+			_kernelname += "+Generic";
+		}
+	}
+
+	template<typename NB, typename EL>
+	void ForceFieldManager::SetInterKernels()
+	{
+		_interkernel = &ForceFieldManager::EvaluateInterNeighbors<NB, EL, true>;
+		_energykernel = &ForceFieldManager::EvaluateInterNeighbors<NB, EL, false>;
+		_deltakernel = &ForceFieldManager::EvaluateDeltaNeighbors<NB, EL>;
 	}
 
 	// Add a constraint to a world.
@@ -157,95 +310,471 @@ namespace SAPHRON
 		return energy;
 	}
 
-	EPTuple ForceFieldManager::EvaluateInterEnergy(const Particle& particle) const
+	// Box of a world for batched Lennard-Jones kernels.
+	static LennardJonesBatchBox GetBatchBox(const World& world)
 	{
-		if(_nonbondedforcefields.empty())
-			return EPTuple();
+		LennardJonesBatchBox box;
+		auto& H = world.GetHMatrix();
+		box.l[0] = world.GetPeriodicX() ? H(0,0) : 0.0;
+		box.l[1] = world.GetPeriodicY() ? H(1,1) : 0.0;
+		box.l[2] = world.GetPeriodicZ() ? H(2,2) : 0.0;
+		for(int d = 0; d < 3; ++d)
+			box.hl[d] = box.l[d]/2.0;
+		return box;
+	}
 
-		double intere = 0, electroe = 0, pxx = 0, 
-		       pxy = 0, pxz = 0, pyy = 0, pyz = 0, 
-			   pzz = 0, recipro = 0;
+	bool ForceFieldManager::HasConstraints(const World& world) const
+	{
+		auto id = world.GetID();
+		return (int)_constraints.size() - 1 >= id && !_constraints[id].empty();
+	}
 
-		// Begin timer.
-		auto& sim = SimInfo::Instance();
-		sim.StartTimer("e_inter");
+	template<typename NB, typename EL, bool VIRIAL>
+	inline void ForceFieldManager::EvaluateInterPair(const Particle& particle, 
+													 const Particle& neighbor, 
+													 const World* world, 
+													 unsigned int wid,
+													 const EL* electroff,
+													 double& intere, double& electroe, 
+													 double& pxx, double& pxy, double& pxz, 
+													 double& pyy, double& pyz, double& pzz) const
+	{
+		Position rij = particle.GetPosition() - neighbor.GetPosition();
+									
+		if(world != nullptr)
+			world->ApplyMinimumImage(&rij);
 
-		// Get appropriate world and ID.
-		World* world = particle.GetWorld();
-		if(!particle.HasChildren())
+		// Skip pairs beyond every forcefield's cutoff.
+		auto si = particle.GetSpeciesID();
+		auto sj = neighbor.GetSpeciesID();
+		auto rsq = fdot(rij, rij);
+		if(rsq > GetCutoffSq(wid, si, sj))
+			return;
+
+		Interaction interij, electroij;
+
+		// Interaction containing energy and virial.
+		if(auto* ff = GetNonBondedForceField(si, sj))
+			interij = EvaluateKernel(static_cast<const NB*>(ff), particle, neighbor, rij, rsq, wid);
+
+		//Electrostatics containing energy and virial
+		electroij = EvaluateKernel(electroff, particle, neighbor, rij, rsq, wid);
+		
+		intere += interij.energy; // Sum nonbonded van der Waal energy.
+		electroe += electroij.energy; // Sum electrostatic energy
+
+		if(!VIRIAL)
+			return;
+
+		// If particle has parent, compute vector between parent Particle(s).
+		Position rab = rij;
+		if(particle.HasParent() && neighbor.HasParent())
 		{
-			unsigned wid = (world == nullptr) ? 0 : world->GetID();
-			auto& neighbors = particle.GetNeighbors();
-			auto n = neighbors.size();
+			rab = particle.GetParent()->GetPosition() - neighbor.GetParent()->GetPosition();
+			if(world != nullptr)
+				world->ApplyMinimumImage(&rab);
+
+		}
+		else if(neighbor.HasParent() && !particle.HasParent()) 
+		{
+			rab = particle.GetPosition() - neighbor.GetParent()->GetPosition();
+			if(world != nullptr)
+				world->ApplyMinimumImage(&rab);
+		}
+		else if(!neighbor.HasParent() && particle.HasParent()) {
+			rab = particle.GetParent()->GetPosition() - neighbor.GetPosition();
+			if(world != nullptr)
+				world->ApplyMinimumImage(&rab);
+		}
+
+		auto totalvirial = interij.virial + electroij.virial;
+		
+		pxx += totalvirial * rij[0] * rab[0];
+		pyy += totalvirial * rij[1] * rab[1];
+		pzz += totalvirial * rij[2] * rab[2];
+		pxy += totalvirial * 0.5 * (rij[0] * rab[1] + rij[1] * rab[0]);
+		pxz += totalvirial * 0.5 * (rij[0] * rab[2] + rij[2] * rab[0]);
+		pyz += totalvirial * 0.5 * (rij[1] * rab[2] + rij[2] * rab[1]);
+	}
+
+	template<typename NB, typename EL, bool VIRIAL>
+	void ForceFieldManager::EvaluateInterNeighbors(const Particle& particle, 
+												   int index,
+												   const World* world, 
+												   unsigned int wid,
+												   double& intere, double& electroe, 
+												   double& pxx, double& pxy, double& pxz, 
+												   double& pyy, double& pyz, double& pzz) const
+	{
+		auto* electroff = KernelCast<EL>(_electroff);
+		auto neighbors = particle.GetNeighbors();
+		auto* indices = neighbors.indices();
+		auto n = neighbors.size();
+		bool half = index >= 0 && indices != nullptr;
+
+		double ie = 0, ee = 0, xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+
+		// World evaluations (index >= 0) are already parallel over primitives.
+		#ifdef PARALLEL_INTER
+		#pragma omp parallel for reduction(+:ie,ee,xx,xy,xz,yy,yz,zz) if(index < 0 && n >= MIN_INTER_NEIGH)
+		#endif
+		for(size_t k = 0; k < n; ++k)
+		{
+			if(half && indices[k] < (uint32_t)index)
+				continue;
+
+			EvaluateInterPair<NB, EL, VIRIAL>(particle, *neighbors[k], world, wid, electroff, 
+											  ie, ee, xx, xy, xz, yy, yz, zz);
+		}
+
+		intere += ie; electroe += ee;
+		pxx += xx; pxy += xy; pxz += xz;
+		pyy += yy; pyz += yz; pzz += zz;
+	}
+
+	template<typename NB, bool VIRIAL>
+	void ForceFieldManager::EvaluateInterBatched(const Particle& particle, 
+												 int index,
+												 const World* world, 
+												 unsigned int wid,
+												 double& intere, double& electroe, 
+												 double& pxx, double& pxy, double& pxz, 
+												 double& pyy, double& pyz, double& pzz) const
+	{
+		// Particles of molecules need parent-to-parent virials.
+		if(world == nullptr || particle.HasParent())
+		{
+			EvaluateInterNeighbors<NB, NoForceField, VIRIAL>(particle, index, world, wid, intere, electroe, 
+			                                                 pxx, pxy, pxz, pyy, pyz, pzz);
+			return;
+		}
+
+		auto neighbors = particle.GetNeighbors();
+		auto* indices = neighbors.indices();
+		int n = neighbors.size();
+		bool half = index >= 0 && indices != nullptr;
+		auto si = particle.GetSpeciesID();
+		auto& pi = particle.GetPosition();
+		auto kernel = GetLennardJonesBatchKernel();
+		auto box = GetBatchBox(*world);
+
+		double ie = 0, ee = 0, xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+
+		#ifdef PARALLEL_INTER
+		#pragma omp parallel reduction(+:ie,ee,xx,xy,xz,yy,yz,zz) if(index < 0 && n >= MIN_INTER_NEIGH)
+		#endif
+		{
+			LennardJonesBatchSums sums;
 
 			#ifdef PARALLEL_INTER
-			#pragma omp parallel for reduction(+:intere,electroe,pxx,pxy,pxz,pyy,pyz,pzz) if(n >= MIN_INTER_NEIGH)
+			#pragma omp for
 			#endif
-			for(size_t k = 0; k < n; ++k)
+			for(int b = 0; b < n; b += LJ_BATCH_SIZE)
 			{
-				auto* neighbor = neighbors[k];
-
-				Position rij = particle.GetPosition() - neighbor->GetPosition();
-											
-				if(world != nullptr)
-					world->ApplyMinimumImage(&rij);
-
-				// If particle has parent, compute vector between parent Particle(s).
-				Position rab = rij;
-				if(particle.HasParent() && neighbor->HasParent())
+				LennardJonesBatch batch;
+				int m = 0;
+				for(int k = b; k < std::min(b + LJ_BATCH_SIZE, n); ++k)
 				{
-					rab = particle.GetParent()->GetPosition() - neighbor->GetParent()->GetPosition();
-					if(world != nullptr)
-						world->ApplyMinimumImage(&rab);
+					if(half && indices[k] < (uint32_t)index)
+						continue;
 
+					// Molecular neighbors are evaluated pair-wise.
+					auto& neighbor = *neighbors[k];
+					if(neighbor.HasParent())
+					{
+						EvaluateInterPair<NB, NoForceField, VIRIAL>(particle, neighbor, world, wid, nullptr, 
+						                                            ie, ee, xx, xy, xz, yy, yz, zz);
+						continue;
+					}
+
+					auto* ff = GetNonBondedForceField(si, neighbor.GetSpeciesID());
+					if(ff == nullptr)
+						continue;
+
+					auto& pj = neighbor.GetPosition();
+					batch.dx[m] = pi[0] - pj[0];
+					batch.dy[m] = pi[1] - pj[1];
+					batch.dz[m] = pi[2] - pj[2];
+					static_cast<const NB*>(ff)->GetBatchParameters(wid, batch.eps4[m], batch.sigsq[m], 
+					                                                batch.rcsq[m], batch.shift[m]);
+					++m;
 				}
-				else if(neighbor->HasParent() && !particle.HasParent()) 
-				{
-					rab = particle.GetPosition() - neighbor->GetParent()->GetPosition();
-					if(world != nullptr)
-						world->ApplyMinimumImage(&rab);
-				}
-				else if(!neighbor->HasParent() && particle.HasParent()) {
-					rab = particle.GetParent()->GetPosition() - neighbor->GetPosition();
-					if(world != nullptr)
-						world->ApplyMinimumImage(&rab);
-				}
 
-				auto it = _nonbondedforcefields.find({particle.GetSpeciesID(),neighbor->GetSpeciesID()});
+				kernel(batch, m, box, sums);
+			}
+
+			// Kernels always accumulate the virial; it is cheap per lane.
+			ie += LennardJonesBatchSums::Total(sums.energy);
+			if(VIRIAL)
+			{
+				xx += LennardJonesBatchSums::Total(sums.xx);
+				xy += LennardJonesBatchSums::Total(sums.xy);
+				xz += LennardJonesBatchSums::Total(sums.xz);
+				yy += LennardJonesBatchSums::Total(sums.yy);
+				yz += LennardJonesBatchSums::Total(sums.yz);
+				zz += LennardJonesBatchSums::Total(sums.zz);
+			}
+		}
+
+		intere += ie; electroe += ee;
+		pxx += xx; pxy += xy; pxz += xz;
+		pyy += yy; pyz += yz; pzz += zz;
+	}
+
+	template<typename NB, typename EL>
+	inline void ForceFieldManager::EvaluateDeltaPair(const Particle& particle, 
+													 const Particle& trial, 
+													 const Particle& neighbor, 
+													 const Position& dr, 
+													 const World* world, 
+													 unsigned int wid, 
+													 const EL* electroff, 
+													 double& intere, double& electroe) const
+	{
+		auto si = particle.GetSpeciesID();
+		auto sj = neighbor.GetSpeciesID();
+		auto rcsq = GetCutoffSq(wid, si, sj);
+		auto* ff = GetNonBondedForceField(si, sj);
+
+		Position rij = particle.GetPosition() - neighbor.GetPosition();
+		Position rnew = rij;
+		rnew += dr;
+		if(world != nullptr)
+		{
+			world->ApplyMinimumImage(&rij);
+			world->ApplyMinimumImage(&rnew);
+		}
+
+		// Subtract old and add new pair energy.
+		auto rsq = fdot(rij, rij);
+		if(rsq <= rcsq)
+		{
+			if(ff != nullptr)
+				intere -= EvaluateKernel(static_cast<const NB*>(ff), particle, neighbor, rij, rsq, wid).energy;
+			electroe -= EvaluateKernel(electroff, particle, neighbor, rij, rsq, wid).energy;
+		}
+
+		rsq = fdot(rnew, rnew);
+		if(rsq <= rcsq)
+		{
+			if(ff != nullptr)
+				intere += EvaluateKernel(static_cast<const NB*>(ff), trial, neighbor, rnew, rsq, wid).energy;
+			electroe += EvaluateKernel(electroff, trial, neighbor, rnew, rsq, wid).energy;
+		}
+	}
+
+	template<typename NB, typename EL>
+	void ForceFieldManager::EvaluateDeltaNeighbors(const Particle& particle, 
+												   const Particle& trial, 
+												   const Position& dr, 
+												   const Particle* parent, 
+												   const World* world, 
+												   unsigned int wid, 
+												   double& intere, double& electroe) const
+	{
+		auto* electroff = KernelCast<EL>(_electroff);
+		auto neighbors = particle.GetNeighbors();
+		int n = neighbors.size();
+
+		double ie = 0, ee = 0;
+
+		#ifdef PARALLEL_INTER
+		#pragma omp parallel for reduction(+:ie,ee) if(n >= MIN_INTER_NEIGH)
+		#endif
+		for(int k = 0; k < n; ++k)
+		{
+			auto& neighbor = *neighbors[k];
 
-				Interaction interij, electroij;
+			// Pairs within a displaced molecule do not change.
+			if(parent != nullptr && neighbor.GetParent() == parent)
+				continue;
 
-				// Interaction containing energy and virial.
-				if(it != _nonbondedforcefields.end())
+			EvaluateDeltaPair<NB, EL>(particle, trial, neighbor, dr, world, wid, electroff, ie, ee);
+		}
+
+		intere += ie; 
+		electroe += ee;
+	}
+
+	template<typename NB>
+	void ForceFieldManager::EvaluateDeltaBatched(const Particle& particle, 
+												 const Particle& trial, 
+												 const Position& dr, 
+												 const Particle* parent, 
+												 const World* world, 
+												 unsigned int wid, 
+												 double& intere, double& electroe) const
+	{
+		if(world == nullptr || particle.HasParent())
+		{
+			EvaluateDeltaNeighbors<NB, NoForceField>(particle, trial, dr, parent, world, wid, intere, electroe);
+			return;
+		}
+
+		auto neighbors = particle.GetNeighbors();
+		int n = neighbors.size();
+		auto si = particle.GetSpeciesID();
+		auto& pi = particle.GetPosition();
+		auto kernel = GetLennardJonesBatchKernel();
+		auto box = GetBatchBox(*world);
+
+		double ie = 0, ee = 0;
+
+		#ifdef PARALLEL_INTER
+		#pragma omp parallel reduction(+:ie,ee) if(n >= MIN_INTER_NEIGH)
+		#endif
+		{
+			LennardJonesBatchSums oldsums, newsums;
+
+			#ifdef PARALLEL_INTER
+			#pragma omp for
+			#endif
+			for(int b = 0; b < n; b += LJ_BATCH_SIZE)
+			{
+				// Old and new distances share parameters.
+				LennardJonesBatch oldb, newb;
+				int m = 0;
+				for(int k = b; k < std::min(b + LJ_BATCH_SIZE, n); ++k)
 				{
-					auto* ff = it->second;
-					interij = ff->Evaluate(particle, *neighbor, rij, wid);
-				}
+					// Molecular neighbors are evaluated pair-wise.
+					auto& neighbor = *neighbors[k];
+					if(neighbor.HasParent())
+					{
+						EvaluateDeltaPair<NB, NoForceField>(particle, trial, neighbor, dr, world, wid, nullptr, ie, ee);
+						continue;
+					}
 
-				//Electrostatics containing energy and virial
-				if(_electroff != nullptr) 
-					electroij = _electroff->Evaluate(particle, *neighbor, rij, wid);
-				
-				intere += interij.energy; // Sum nonbonded van der Waal energy.
-				electroe += electroij.energy; // Sum electrostatic energy
+					auto* ff = GetNonBondedForceField(si, neighbor.GetSpeciesID());
+					if(ff == nullptr)
+						continue;
+
+					auto& pj = neighbor.GetPosition();
+					oldb.dx[m] = pi[0] - pj[0];
+					oldb.dy[m] = pi[1] - pj[1];
+					oldb.dz[m] = pi[2] - pj[2];
+					newb.dx[m] = oldb.dx[m] + dr[0];
+					newb.dy[m] = oldb.dy[m] + dr[1];
+					newb.dz[m] = oldb.dz[m] + dr[2];
+					static_cast<const NB*>(ff)->GetBatchParameters(wid, oldb.eps4[m], oldb.sigsq[m], 
+					                                                oldb.rcsq[m], oldb.shift[m]);
+					newb.eps4[m] = oldb.eps4[m];
+					newb.sigsq[m] = oldb.sigsq[m];
+					newb.rcsq[m] = oldb.rcsq[m];
+					newb.shift[m] = oldb.shift[m];
+					++m;
+				}
 
-				auto totalvirial = interij.virial + electroij.virial;
-				
-				pxx += totalvirial * rij[0] * rab[0];
-				pyy += totalvirial * rij[1] * rab[1];
-				pzz += totalvirial * rij[2] * rab[2];
-				pxy += totalvirial * 0.5 * (rij[0] * rab[1] + rij[1] * rab[0]);
-				pxz += totalvirial * 0.5 * (rij[0] * rab[2] + rij[2] * rab[0]);
-				pyz += totalvirial * 0.5 * (rij[1] * rab[2] + rij[2] * rab[1]);				
+				kernel(oldb, m, box, oldsums);
+				kernel(newb, m, box, newsums);
 			}
+
+			ie += LennardJonesBatchSums::Total(newsums.energy) - LennardJonesBatchSums::Total(oldsums.energy);
+		}
+
+		intere += ie; 
+		electroe += ee;
+	}
+
+	EPTuple ForceFieldManager::EvaluateDeltaEnergy(const Particle& particle, const Position& position) const
+	{
+		if(_nonbondedforcefields.empty())
+			return EPTuple();
+
+		double intere = 0, electroe = 0;
+
+		ProfileScope scope(ProfileInter);
+
+		World* world = particle.GetWorld();
+		unsigned wid = (world == nullptr) ? 0 : world->GetID();
+		Position dr = position - particle.GetPosition();
+
+		// Children are displaced rigidly with the particle.
+		if(particle.HasChildren())
+			for(auto& child : particle)
+				(this->*_deltakernel)(*child, *child, dr, &particle, world, wid, intere, electroe);
+		else
+			(this->*_deltakernel)(particle, particle, dr, nullptr, world, wid, intere, electroe);
+
+		double recipro = (_electroff != nullptr) ? _electroff->ReciprocalDelta(particle, dr) : 0;
+		return EPTuple{intere, 0, electroe, 0, 0, 0, 0, 0, recipro, 0, 0, 0, 0, 0, 0, 0, 0};
+	}
+
+	EPTuple ForceFieldManager::EvaluateDeltaEnergy(const Particle& particle, 
+	                                               const Position& position, 
+	                                               const Director& director) const
+	{
+		assert(!particle.HasChildren() && !particle.HasParent());
+		if(_nonbondedforcefields.empty())
+			return EPTuple();
+
+		double intere = 0, electroe = 0;
+
+		ProfileScope scope(ProfileInter);
+
+		World* world = particle.GetWorld();
+		unsigned wid = (world == nullptr) ? 0 : world->GetID();
+		Position dr = position - particle.GetPosition();
+
+		// Detached scratch carrying the new director for anisotropic forcefields. 
+		// Threads beyond those the scratch was sized for use a temporary.
+		std::unique_ptr<Particle> temporary;
+		auto tid = GetThreadNumber();
+		auto& trial = (tid < (int)_trials.size()) ? _trials[tid] : temporary;
+		if(trial == nullptr)
+			trial.reset(new Particle(position, director, particle.GetSpecies()));
+		else
+		{
+			if(trial->GetSpeciesID() != particle.GetSpeciesID())
+				trial->SetSpeciesID(particle.GetSpeciesID());
+			trial->SetPosition(position);
+			trial->SetDirector(director);
+		}
+		trial->SetCharge(particle.GetCharge());
+		(this->*_deltakernel)(particle, *trial, dr, nullptr, world, wid, intere, electroe);
+
+		double recipro = (_electroff != nullptr) ? _electroff->ReciprocalDelta(particle, dr) : 0;
+		return EPTuple{intere, 0, electroe, 0, 0, 0, 0, 0, recipro, 0, 0, 0, 0, 0, 0, 0, 0};
+	}
+
+	EPTuple ForceFieldManager::EvaluateInterEnergy(const Particle& particle) const
+	{
+		ProfileScope scope(ProfileInter);
+		auto ep = EvaluateInterEnergy(particle, _interkernel);
+		if(_electroff != nullptr)
+			ep.energy.electrotail += _electroff->ReciprocalSpace(particle);
+		return ep;
+	}
+
+	EPTuple ForceFieldManager::EvaluateInterEnergyOnly(const Particle& particle) const
+	{
+		ProfileScope scope(ProfileInter);
+		auto ep = EvaluateInterEnergy(particle, _energykernel);
+		if(_electroff != nullptr)
+			ep.energy.electrotail += _electroff->ReciprocalSpace(particle);
+		return ep;
+	}
+
+	EPTuple ForceFieldManager::EvaluateInterEnergy(const Particle& particle, InterKernel kernel) const
+	{
+		if(_nonbondedforcefields.empty())
+			return EPTuple();
+
+		double intere = 0, electroe = 0, pxx = 0, 
+		       pxy = 0, pxz = 0, pyy = 0, pyz = 0, 
+			   pzz = 0, recipro = 0;
+
+		// Get appropriate world and ID.
+		World* world = particle.GetWorld();
+		if(!particle.HasChildren())
+		{
+			unsigned wid = (world == nullptr) ? 0 : world->GetID();
+			(this->*kernel)(particle, -1, world, wid, 
+			                intere, electroe, pxx, pxy, pxz, pyy, pyz, pzz);
 		}
 		EPTuple ep{intere, 0, electroe, 0, 0, 0, 0, 0, recipro, 0, -pxx, -pxy, -pxz, -pyy, -pyz, -pzz, 0};				
 		
-		// End timer.
-		sim.AddTime("e_inter");
-		
 		for(auto& child : particle)
-			ep += EvaluateInterEnergy(*child);	
+			ep += EvaluateInterEnergy(*child, kernel);	
 		
 		// Divide virial by volume to get pressure if there's a world.
 		if(world != nullptr)
@@ -257,88 +786,280 @@ namespace SAPHRON
 	EPTuple ForceFieldManager::EvaluateInterEnergy(const World& world) const
 	{
 		EPTuple ep; 
-		for(auto& particle : world)
-			ep += EvaluateInterEnergy(*particle);
+		if(!_nonbondedforcefields.empty())
+		{
+			double intere = 0, electroe = 0, pxx = 0, 
+			       pxy = 0, pxz = 0, pyy = 0, pyz = 0, pzz = 0;
+
+			ProfileScope scope(ProfileInter);
+
+			// Neighbor lists are full (symmetric) so we only 
+			// evaluate a pair from the primitive with the lower index.
+			unsigned wid = world.GetID();
+			int n = world.GetPrimitiveCount();
+
+			// Each thread sums a static block of primitives. Partial sums 
+			// are reduced in thread order so results are reproducible 
+			// for a given number of threads.
+			std::vector<std::array<double, 8>> partial(GetMaxThreads(), std::array<double, 8>{});
+
+			#ifdef PARALLEL_INTER
+			#pragma omp parallel
+			#endif
+			{
+				double ie = 0, ee = 0, xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+
+				#ifdef PARALLEL_INTER
+				#pragma omp for schedule(static)
+				#endif
+				for(int i = 0; i < n; ++i)
+					(this->*_interkernel)(*world.SelectPrimitive(i), i, &world, wid, 
+					                      ie, ee, xx, xy, xz, yy, yz, zz);
+
+				partial[GetThreadNumber()] = {{ie, ee, xx, xy, xz, yy, yz, zz}};
+			}
+
+			for(auto& s : partial)
+			{
+				intere += s[0]; electroe += s[1];
+				pxx += s[2]; pxy += s[3]; pxz += s[4];
+				pyy += s[5]; pyz += s[6]; pzz += s[7];
+			}
+
+			ep = EPTuple{intere, 0, electroe, 0, 0, 0, 0, 0, 0, 0, -pxx, -pxy, -pxz, -pyy, -pyz, -pzz, 0};
+			ep.pressure /= world.GetVolume();
+		}
 		
 		if(_electroff != nullptr)
 			ep.energy.electrotail = _electroff->ReciprocalSpace(world);
 
-		ep.energy.intervdw *= 0.5;
-		ep.energy.interelectrostatic *= 0.5;
-		ep.pressure *= 0.5;
 		return ep;
 	}
 
 	EPTuple ForceFieldManager::EvaluateIntraEnergy(const World& world) const
 	{
-		EPTuple ep; 
+		ProfileScope scope(ProfileIntra);
+
+		// Pair sets are built up front since the cache cannot be modified 
+		// in parallel.
 		for(auto& particle : world)
-			ep += EvaluateIntraEnergy(*particle);
+			PrepareIntraTopology(*particle);
+
+		// Particles are summed as in EvaluateInterEnergy(world).
+		int n = world.GetParticleCount();
+		std::vector<EPTuple> partial(GetMaxThreads());
+
+		#ifdef PARALLEL_INTRA
+		#pragma omp parallel
+		#endif
+		{
+			EPTuple ep;
+
+			#ifdef PARALLEL_INTRA
+			#pragma omp for schedule(static)
+			#endif
+			for(int i = 0; i < n; ++i)
+				ep += EvaluateIntraParticle(*world.SelectParticle(i), nullptr, -1, false);
+
+			partial[GetThreadNumber()] = ep;
+		}
+
+		EPTuple ep;
+		for(auto& s : partial)
+			ep += s;
+
+		// Connectivities are not thread safe.
+		for(auto& particle : world)
+			ep.energy.connectivity += EvaluateConnectivityEnergy(*particle);
 
 		return ep;
 	}
 
 	EPTuple ForceFieldManager::EvaluateIntraEnergy(const Particle& particle) const
+	{
+		ProfileScope scope(ProfileIntra);
+
+		const IntraTopology* topology = nullptr;
+		int index = -1;
+		if(particle.HasParent())
+		{
+			auto& siblings = particle.GetParent()->GetChildren();
+			topology = GetIntraTopology(*particle.GetParent());
+			index = std::find(siblings.begin(), siblings.end(), &particle) - siblings.begin();
+		}
+
+		auto ep = EvaluateIntraParticle(particle, topology, index, true);
+		ep.energy.connectivity += EvaluateConnectivityEnergy(particle);
+
+		return ep;
+	}
+
+	double ForceFieldManager::EvaluateConnectivityEnergy(const Particle& particle) const
+	{
+		double e = 0;
+		for(auto& c : particle.GetConnectivities())
+			e += c->EvaluateEnergy(particle);
+
+		for(auto& child : particle)
+			e += 0.5*EvaluateConnectivityEnergy(*child);
+
+		return e;
+	}
+
+	void ForceFieldManager::BuildIntraTopology(const Particle& parent, IntraTopology& topology) const
+	{
+		auto& children = parent.GetChildren();
+		int n = children.size();
+
+		topology.species.resize(n);
+		topology.words = (n + 63)/64;
+		topology.mask.assign(n*topology.words, 0);
+		topology.scaled.assign(n, {});
+
+		std::unordered_map<const Particle*, int> indices;
+		for(int i = 0; i < n; ++i)
+		{
+			topology.species[i] = children[i]->GetSpeciesID();
+			indices[children[i]] = i;
+		}
+
+		// Bonds apart from child i (breadth first up to 1-4).
+		std::vector<int> hops(n);
+		std::vector<int> shell, next;
+		for(int i = 0; i < n; ++i)
+		{
+			std::fill(hops.begin(), hops.end(), 0);
+			shell.assign(1, i);
+			for(int h = 1; h <= 3 && !shell.empty(); ++h)
+			{
+				next.clear();
+				for(auto k : shell)
+					for(auto* b : children[k]->GetBondedNeighbors())
+					{
+						auto it = indices.find(b);
+						if(it != indices.end() && it->second != i && hops[it->second] == 0)
+						{
+							hops[it->second] = h;
+							next.push_back(it->second);
+						}
+					}
+				std::swap(shell, next);
+			}
+
+			auto* row = &topology.mask[i*topology.words];
+			for(int j = 0; j < n; ++j)
+			{
+				if(j == i)
+					continue;
+
+				auto scale = (hops[j] == 0) ? 1. : _intrascale[hops[j] - 1];
+				if(scale == 1.)
+					row[j/64] |= uint64_t(1) << (j % 64);
+				else if(scale != 0.)
+					topology.scaled[i].emplace_back(j, scale);
+			}
+		}
+	}
+
+	const ForceFieldManager::IntraTopology* ForceFieldManager::GetIntraTopology(const Particle& parent, 
+	                                                                            IntraTopology* scratch) const
+	{
+		auto& children = parent.GetChildren();
+		auto stamp = parent.GetTopologyStamp();
+		auto it = _topologies.find(parent.GetSpeciesID());
+		if(it != _topologies.end())
+		{
+			auto& topology = it->second;
+			bool valid = topology.stamps.count(stamp) && 
+			             topology.species.size() == children.size();
+			for(size_t i = 0; valid && i < children.size(); ++i)
+				valid = topology.species[i] == children[i]->GetSpeciesID();
+
+			if(valid)
+				return &topology;
+		}
+
+		if(scratch != nullptr)
+		{
+			BuildIntraTopology(parent, *scratch);
+			return scratch;
+		}
+
+		// Keep the cached set if this molecule has the same one.
+		IntraTopology fresh;
+		BuildIntraTopology(parent, fresh);
+		auto& topology = _topologies[parent.GetSpeciesID()];
+		if(!topology.Matches(fresh))
+			topology = std::move(fresh);
+		topology.stamps.insert(stamp);
+		return &topology;
+	}
+
+	void ForceFieldManager::PrepareIntraTopology(const Particle& particle) const
+	{
+		if(!particle.HasChildren())
+			return;
+
+		GetIntraTopology(particle);
+		for(auto& child : particle)
+			PrepareIntraTopology(*child);
+	}
+
+	EPTuple ForceFieldManager::EvaluateIntraParticle(const Particle& particle, 
+	                                                 const IntraTopology* topology, 
+	                                                 int index, 
+	                                                 bool nested) const
 	{
 		EPTuple ep;
 
-		// Begin timer.
-		auto& sim = SimInfo::Instance();
-		sim.StartTimer("e_intra");
-		
 		World* world = particle.GetWorld();
 		unsigned int wid = (world == nullptr) ? 0 : world->GetID();
 
-		// Go to particle parent and evaluate non-bonded interactions with siblings.
-        if(particle.HasParent())
-        { 
+		// Evaluate non-bonded interactions with siblings in the pair set.
+		if(particle.HasParent())
+		{ 
 			double electro = 0, vdw = 0;
-        	auto& siblings = particle.GetParent()->GetChildren();
-        	auto n = siblings.size();
-
-        	#ifdef PARALLEL_INTRA
-        	#pragma omp parallel for reduction(+:electro,vdw) if(n >= MIN_INTRA_NEIGH)
-        	#endif
-            for(size_t i = 0; i < n; ++i)
-            {
-            	auto& sibling = siblings[i];
-                if(!particle.IsBondedNeighbor(sibling) && sibling != &particle)
-                {
-                	
-                	Position rij = particle.GetPosition() - sibling->GetPosition();
-					
-					if(world != nullptr)
-						world->ApplyMinimumImage(&rij);
-
-					auto it = _nonbondedforcefields.find({particle.GetSpeciesID(), sibling->GetSpeciesID()});
-
-					//Electrostatics containing energy and virial
-					if(_electroff != nullptr)
-					{
-						auto ij = _electroff->Evaluate(particle, *sibling, rij, wid);
-						electro += ij.energy;
-					}		
+			auto& siblings = particle.GetParent()->GetChildren();
+			auto& species = topology->species;
+			auto words = topology->words;
+			auto* row = &topology->mask[index*words];
+			auto si = species[index];
+
+			auto evaluate = [&](int j, double scale, double& e, double& v) {
+				auto& sibling = siblings[j];
+				Position rij = particle.GetPosition() - sibling->GetPosition();
+				
+				if(world != nullptr)
+					world->ApplyMinimumImage(&rij);
 
-					if(it != _nonbondedforcefields.end())
-					{
-						auto* ff = it->second;
-						auto ij = ff->Evaluate(particle, *sibling, rij, wid);
+				//Electrostatics containing energy and virial
+				if(_electroff != nullptr)
+					e += scale*_electroff->Evaluate(particle, *sibling, rij, wid).energy;
 
-						vdw += ij.energy; // Sum nonbonded energy.
-					}
-                }
-            }
+				auto* ff = GetNonBondedForceField(si, species[j]);
+				if(ff != nullptr)
+					v += scale*ff->Evaluate(particle, *sibling, rij, wid).energy;
+			};
+
+			#ifdef PARALLEL_INTRA
+			#pragma omp parallel for reduction(+:electro,vdw) if(nested && (int)siblings.size() >= MIN_INTRA_NEIGH)
+			#endif
+			for(int w = 0; w < words; ++w)
+				for(auto bits = row[w]; bits != 0; bits &= bits - 1)
+					evaluate(64*w + __builtin_ctzll(bits), 1., electro, vdw);
 
-            ep.energy.intraelectrostatic += electro;
-            ep.energy.intravdw += vdw;
-        }
+			for(auto& pair : topology->scaled[index])
+				evaluate(pair.first, pair.second, electro, vdw);
 
-        for(auto* bondedneighbor : particle.GetBondedNeighbors())
+			ep.energy.intraelectrostatic += electro;
+			ep.energy.intravdw += vdw;
+		}
+
+		for(auto* bondedneighbor : particle.GetBondedNeighbors())
 		{
-			auto it = _bondedforcefields.find({particle.GetSpeciesID(),bondedneighbor->GetSpeciesID()});
-			if(it != _bondedforcefields.end())
+			auto* ff = GetBondedForceField(particle.GetSpeciesID(), bondedneighbor->GetSpeciesID());
+			if(ff != nullptr)
 			{
-				auto ff = it->second;
 				Position rij = particle.GetPosition() - bondedneighbor->GetPosition();
 				
 				// Minimum image convention.
@@ -350,14 +1071,14 @@ namespace SAPHRON
 			}
 		}
 
-		for(auto& c : particle.GetConnectivities())
-			ep.energy.connectivity += c->EvaluateEnergy(particle);
-		
-		// End timer.
-		sim.AddTime("e_intra");
-		
-		for(auto& child : particle)
-			ep += 0.5*EvaluateIntraEnergy(*child);
+		if(particle.HasChildren())
+		{
+			IntraTopology scratch;
+			auto* children = GetIntraTopology(particle, nested ? nullptr : &scratch);
+			auto n = particle.GetChildren().size();
+			for(size_t i = 0; i < n; ++i)
+				ep += 0.5*EvaluateIntraParticle(*particle.GetChildren()[i], children, i, nested);
+		}
 
 		return ep;
 	}
@@ -425,6 +1146,13 @@ namespace SAPHRON
 			_electroff->Serialize(electro);
 		}
 
+		if(_ecache)
+			json["forcefields"]["energy_cache"] = true;
+
+		if(_intrascale != std::array<double, 3>{{0., 1., 1.}})
+			for(int i = 0; i < 3; ++i)
+				json["forcefields"]["intra_scaling"][i] = _intrascale[i];
+
 		if(_constraints.size() != 0)
 		{
 			auto& constraints = json["forcefields"]["constraints"];
@@ -443,7 +1171,73 @@ namespace SAPHRON
 
 	EPTuple ForceFieldManager::EvaluateEnergy(const Particle& particle) const
 	{
-		return EvaluateInterEnergy(particle) + EvaluateIntraEnergy(particle);
+		auto* world = particle.GetWorld();
+		if(!_ecache || world == nullptr)
+			return EvaluateInterEnergy(particle) + EvaluateIntraEnergy(particle);
+
+		// Reciprocal space depends on every charge so it is not cached.
+		world->TrackEnergyStamps();
+		EPTuple ep;
+		if(auto* cached = particle.GetCachedEnergy(_ekey))
+		{
+			ep = *cached;
+			#ifndef NDEBUG
+			auto ef = EvaluateInterEnergy(particle) + EvaluateIntraEnergy(particle);
+			ef.energy.electrotail = 0;
+			assert(std::abs(ef.energy.total() - ep.energy.total()) <= 
+			       1e-8*std::max(1.0, std::abs(ef.energy.total())));
+			#endif
+		}
+		else
+		{
+			ep = EvaluateInterEnergy(particle) + EvaluateIntraEnergy(particle);
+			ep.energy.electrotail = 0;
+			particle.SetCachedEnergy(_ekey, ep);
+		}
+
+		if(_electroff != nullptr)
+			ep.energy.electrotail = _electroff->ReciprocalSpace(particle);
+		return ep;
+	}
+
+	EPTuple ForceFieldManager::EvaluateEnergyOnly(const Particle& particle) const
+	{
+		if(_ecache)
+		{
+			if(auto* cached = particle.GetCachedEnergy(_ekey))
+			{
+				EPTuple ep;
+				ep.energy = cached->energy;
+				if(_electroff != nullptr)
+					ep.energy.electrotail = _electroff->ReciprocalSpace(particle);
+				return ep;
+			}
+		}
+
+		return EvaluateInterEnergyOnly(particle) + EvaluateIntraEnergy(particle);
+	}
+
+	double ForceFieldManager::CheckEnergyCache(const World& world) const
+	{
+		double dmax = 0;
+		std::vector<const Particle*> stack(world.begin(), world.end());
+		while(!stack.empty())
+		{
+			auto* p = stack.back();
+			stack.pop_back();
+			for(auto* child : p->GetChildren())
+				stack.push_back(child);
+
+			auto* cached = p->GetCachedEnergy(_ekey);
+			if(cached == nullptr)
+				continue;
+
+			auto ep = EvaluateInterEnergy(*p) + EvaluateIntraEnergy(*p);
+			ep.energy.electrotail = 0;
+			dmax = std::max(dmax, std::abs(ep.energy.total() - cached->energy.total()));
+		}
+
+		return dmax;
 	}
 
 	EPTuple ForceFieldManager::EvaluateEnergy(const World& world) const
@@ -10,6 +10,11 @@
 #include <map>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace SAPHRON
 {
@@ -39,12 +44,232 @@ namespace SAPHRON
 		FFMap _uniquenbffs;
 		FFMap _uniquebffs;
 
+		// Dense (species x species) lookup tables of non-bonded and 
+		// bonded forcefields. Species registered after the tables were 
+		// built have no forcefields and fall outside of them.
+		int _nspecies;
+		FFList _nbtable, _btable;
+
+		// Squared cutoff of each species pair for each world beyond which 
+		// neither the non-bonded nor electrostatic forcefield contributes. 
+		// Negative if no forcefield applies to the pair.
+		std::vector<std::vector<double>> _rcsqtable;
+
+		// Rebuilds lookup tables. Called when forcefields change.
+		void BuildTables();
+
+		// Get the non-bonded forcefield between two species or nullptr.
+		inline ForceField* GetNonBondedForceField(int i, int j) const
+		{
+			return (i < _nspecies && j < _nspecies) ? _nbtable[i*_nspecies + j] : nullptr;
+		}
+
+		// Get the bonded forcefield between two species or nullptr.
+		inline ForceField* GetBondedForceField(int i, int j) const
+		{
+			return (i < _nspecies && j < _nspecies) ? _btable[i*_nspecies + j] : nullptr;
+		}
+
+		// Get the squared interaction cutoff between two species in a world.
+		inline double GetCutoffSq(unsigned int wid, int i, int j) const
+		{
+			if(wid >= _rcsqtable.size() || i >= _nspecies || j >= _nspecies)
+				return std::numeric_limits<double>::infinity();
+			return _rcsqtable[wid][i*_nspecies + j];
+		}
+
+		// Evaluates the non-bonded and electrostatic interaction between a 
+		// primitive and its neighbor, accumulating energies and virial terms.
+		// NB and EL are the non-bonded and electrostatic forcefield types, 
+		// ForceField for virtual dispatch or NoForceField if absent. Virial 
+		// terms are skipped unless VIRIAL is set.
+		template<typename NB, typename EL, bool VIRIAL>
+		inline void EvaluateInterPair(const Particle& particle, 
+									  const Particle& neighbor, 
+									  const World* world, 
+									  unsigned int wid,
+									  const EL* electroff,
+									  double& intere, double& electroe, 
+									  double& pxx, double& pxy, double& pxz, 
+									  double& pyy, double& pyz, double& pzz) const;
+
+		// Evaluates the interactions of a primitive with its neighbors. If 
+		// index is not negative, it is the primitive's index in its world 
+		// and only neighbors with a higher index are visited (half list).
+		template<typename NB, typename EL, bool VIRIAL>
+		void EvaluateInterNeighbors(const Particle& particle, 
+									int index,
+									const World* world, 
+									unsigned int wid,
+									double& intere, double& electroe, 
+									double& pxx, double& pxy, double& pxz, 
+									double& pyy, double& pyz, double& pzz) const;
+
+		// Neighbor loop for Lennard-Jones type NB without electrostatics. 
+		// Atomic neighbors are gathered into batches evaluated by a SIMD 
+		// kernel selected for the CPU at runtime. Same arguments as above.
+		template<typename NB, bool VIRIAL>
+		void EvaluateInterBatched(const Particle& particle, 
+								  int index,
+								  const World* world, 
+								  unsigned int wid,
+								  double& intere, double& electroe, 
+								  double& pxx, double& pxy, double& pxz, 
+								  double& pyy, double& pyz, double& pzz) const;
+
+		// Evaluates the change in non-bonded and electrostatic energy of a 
+		// primitive and its neighbor if the primitive were displaced by dr 
+		// and took on the state of trial (director).
+		template<typename NB, typename EL>
+		inline void EvaluateDeltaPair(const Particle& particle, 
+									  const Particle& trial, 
+									  const Particle& neighbor, 
+									  const Position& dr, 
+									  const World* world, 
+									  unsigned int wid, 
+									  const EL* electroff, 
+									  double& intere, double& electroe) const;
+
+		// Evaluates the energy change above over all neighbors of a 
+		// primitive in one pass. Neighbors belonging to parent are 
+		// displaced along with it.
+		template<typename NB, typename EL>
+		void EvaluateDeltaNeighbors(const Particle& particle, 
+									const Particle& trial, 
+									const Position& dr, 
+									const Particle* parent, 
+									const World* world, 
+									unsigned int wid, 
+									double& intere, double& electroe) const;
+
+		// Batched version of the above for Lennard-Jones type NB 
+		// without electrostatics.
+		template<typename NB>
+		void EvaluateDeltaBatched(const Particle& particle, 
+								  const Particle& trial, 
+								  const Position& dr, 
+								  const Particle* parent, 
+								  const World* world, 
+								  unsigned int wid, 
+								  double& intere, double& electroe) const;
+
+		// Neighbor loops instantiated for the forcefield types in use, 
+		// with and without virial.
+		typedef void (ForceFieldManager::*InterKernel)(const Particle&, int, const World*, unsigned int, 
+		                                               double&, double&, double&, double&, 
+		                                               double&, double&, double&, double&) const;
+		InterKernel _interkernel;
+		InterKernel _energykernel;
+		std::string _kernelname;
+
+		// Delta energy neighbor loop instantiated for the forcefield types in use.
+		typedef void (ForceFieldManager::*DeltaKernel)(const Particle&, const Particle&, const Position&, 
+		                                               const Particle*, const World*, unsigned int, 
+		                                               double&, double&) const;
+		DeltaKernel _deltakernel;
+
+		// Scratch primitives carrying trial states for EvaluateDeltaEnergy, 
+		// one per thread, created on first use so trial moves do not 
+		// construct particles.
+		mutable std::vector<std::unique_ptr<Particle>> _trials;
+
+		// Selects the neighbor loop for non-bonded type NB.
+		template<typename NB>
+		void SelectInterKernel(const std::string& name);
+
+		// Sets the neighbor loops for non-bonded type NB and electrostatic type EL.
+		template<typename NB, typename EL>
+		void SetInterKernels();
+
+		// Evaluates the intermolecular energy of a particle using a neighbor loop.
+		EPTuple EvaluateInterEnergy(const Particle& particle, InterKernel kernel) const;
+
+		// Scaling of non-bonded interactions between siblings 1-2, 1-3 
+		// and 1-4 bonds apart.
+		std::array<double, 3> _intrascale;
+
+		// Intramolecular pair set of a molecule species. Children i and j
+		// interact in full if bit j of row i of mask is set, or scaled if 
+		// listed in scaled[i]. Excluded pairs appear in neither.
+		struct IntraTopology
+		{
+			// Topology stamps of molecules known to have this pair set 
+			// (see Particle::GetTopologyStamp).
+			std::unordered_set<unsigned long> stamps;
+
+			// Child species the set was built for.
+			std::vector<int> species;
+
+			// Exclusion bitmap, words per row.
+			int words = 0;
+			std::vector<uint64_t> mask;
+
+			// Scaled pairs (sibling, factor) of each child.
+			std::vector<std::vector<std::pair<int, double>>> scaled;
+
+			// Is the pair set the same as another one, ignoring stamps?
+			bool Matches(const IntraTopology& other) const
+			{
+				return species == other.species && words == other.words && 
+				       mask == other.mask && scaled == other.scaled;
+			}
+		};
+
+		// Intramolecular pair sets by parent species. Molecules of a species 
+		// are assumed to share their bond graph in most cases. A molecule 
+		// with an unknown topology stamp is checked against the cached set 
+		// once, and replaces it if its bonds differ.
+		mutable std::unordered_map<int, IntraTopology> _topologies;
+
+		// Builds the intramolecular pair set of the children of parent.
+		void BuildIntraTopology(const Particle& parent, IntraTopology& topology) const;
+
+		// Gets the pair set of the children of parent, rebuilding the cached 
+		// one if stale. If scratch is provided the cache is left untouched 
+		// and a stale pair set is built into scratch instead.
+		const IntraTopology* GetIntraTopology(const Particle& parent, 
+		                                      IntraTopology* scratch = nullptr) const;
+
+		// Builds stale pair sets of a particle and its descendants.
+		void PrepareIntraTopology(const Particle& particle) const;
+
+		// Evaluates the intramolecular energy of a particle and its children 
+		// excluding connectivities, without timing. topology is the pair set
+		// of the particle's siblings and index its position among them. If 
+		// nested is false the sibling loop is serial and the pair set cache is 
+		// not modified (caller is already parallel).
+		EPTuple EvaluateIntraParticle(const Particle& particle, 
+		                              const IntraTopology* topology, 
+		                              int index, 
+		                              bool nested) const;
+
+		// Evaluates the connectivity energy of a particle and its children.
+		double EvaluateConnectivityEnergy(const Particle& particle) const;
+
+		// Particle energy cache. Energies are stored on the particles 
+		// (see Particle::SetCachedEnergy) under a key which is replaced 
+		// to invalidate all of them.
+		bool _ecache;
+		unsigned long _ekey;
+
+		// Next energy cache key.
+		static unsigned long _nextkey;
+
+		// Invalidates all cached particle energies.
+		void ResetEnergyCache() { _ekey = ++_nextkey; }
+
 	public:
 		typedef FFMap::iterator iterator;
 		typedef FFMap::const_iterator const_iterator;
 		
 		ForceFieldManager() : 
-		_nonbondedforcefields(), _bondedforcefields(), _electroff(nullptr), _constraints(0) {}
+		_nonbondedforcefields(), _bondedforcefields(), _electroff(nullptr), _constraints(0), 
+		_uniquenbffs(), _uniquebffs(), _nspecies(0), _nbtable(0), _btable(0), _rcsqtable(0), 
+		_interkernel(nullptr), _energykernel(nullptr), _kernelname(), _deltakernel(nullptr), _trials(0), 
+		_intrascale{{0., 1., 1.}}, _topologies(), _ecache(false), _ekey(++_nextkey)
+		{
+			BuildTables();
+		}
 
 		// Adds a non-bonded forcefield to the manager.
 		void AddNonBondedForceField(std::string p1type, std::string p2type, ForceField& ff);
@@ -91,27 +316,57 @@ namespace SAPHRON
 		// Evaluate constraint energy of entire world.
 		double EvaluateConstraintEnergy(const World& world) const;
 
+		// Does a world have constraints?
+		bool HasConstraints(const World& world) const;
+
 		// Evaluates the intermolecular energy of a particle.
 		// This includes constraint energy. 
 		EPTuple EvaluateInterEnergy(const Particle& particle) const;
 
-		// Evaluates the intermolecular energy of a world.
+		// Evaluates the intermolecular energy of a particle without 
+		// virial. The pressure returned is zero. For moves which only 
+		// need energy differences.
+		EPTuple EvaluateInterEnergyOnly(const Particle& particle) const;
+
+		// Evaluates the intermolecular energy of a world. Each neighbor 
+		// pair is visited only once (half list). Primitives are split 
+		// across threads and summed in a fixed order.
 		EPTuple EvaluateInterEnergy(const World& world) const;
 
+		// Evaluates the change in intermolecular energy of a particle if it 
+		// (and its children) were translated to position, without modifying 
+		// it. Old and new pair energies are evaluated in one pass over 
+		// neighbors, which must remain valid at the new position (see 
+		// World::IsNeighborListValid). The pressure returned is zero.
+		EPTuple EvaluateDeltaEnergy(const Particle& particle, const Position& position) const;
+
+		// Evaluates the change in intermolecular energy of a primitive 
+		// without a parent if it were moved to position and director. 
+		// Same conditions as above.
+		EPTuple EvaluateDeltaEnergy(const Particle& particle, 
+		                            const Position& position, 
+		                            const Director& director) const;
+
 		// Computes the intramolecular energy of a particle, this includes bond
 		// energies and connectivities.
 		EPTuple EvaluateIntraEnergy(const Particle& particle) const;
 
-		// Computes intramolecular energy of entire world. 
+		// Computes intramolecular energy of entire world. Particles are 
+		// split across threads and summed in a fixed order.
 		EPTuple EvaluateIntraEnergy(const World& world) const;
 
 		// Evaluates tail contributions (long range corrections) for a world.
 		EPTuple EvaluateTailEnergy(const World& world) const;
 
 		// Evaluates the total energy of a particle including inter
-		// and intra.
+		// and intra. Served from the energy cache if enabled.
 		EPTuple EvaluateEnergy(const Particle& particle) const;
 
+		// Evaluates the total energy of a particle without inter-
+		// molecular virial (see EvaluateInterEnergyOnly). Served from 
+		// the energy cache if enabled and present.
+		EPTuple EvaluateEnergyOnly(const Particle& particle) const;
+
 		// Evaluate total energy of the world including inter, intra
 		// and tail.
 		EPTuple EvaluateEnergy(const World& world) const;
@@ -130,5 +385,40 @@ namespace SAPHRON
 
 		// Get (unique) bonded forcefields.
 		const FFMap& GetBondedForceFields() const { return _uniquebffs;	}
+
+		// Get the name of the pair kernel used for intermolecular energies. 
+		// "Generic" denotes virtual dispatch.
+		const std::string& GetKernelName() const { return _kernelname; }
+
+		// Enables or disables caching of particle energies. Cached energies 
+		// are reused until the particle, its neighbors or its world change 
+		// (see World::TrackEnergyStamps). Particles without a world are 
+		// not cached.
+		void SetEnergyCache(bool enabled)
+		{
+			_ecache = enabled;
+			ResetEnergyCache();
+		}
+
+		// Is the particle energy cache enabled?
+		bool IsEnergyCacheEnabled() const { return _ecache; }
+
+		// Sets the scaling of non-bonded (and electrostatic) interactions 
+		// between children of a particle that are 1-2, 1-3 and 1-4 bonds 
+		// apart. Default is to exclude bonded neighbors only {0, 1, 1}.
+		void SetIntraScaling(double s12, double s13, double s14)
+		{
+			_intrascale = {{s12, s13, s14}};
+			_topologies.clear();
+			ResetEnergyCache();
+		}
+
+		// Gets the scaling of 1-2, 1-3 and 1-4 intramolecular interactions.
+		const std::array<double, 3>& GetIntraScaling() const { return _intrascale; }
+
+		// Compares valid cached energies of particles in a world against a 
+		// fresh evaluation. Returns the largest absolute difference in 
+		// total energy.
+		double CheckEnergyCache(const World& world) const;
 	};
 }
@@ -98,6 +98,9 @@ namespace SAPHRON
 			return ep;
 		}
 
+		// Get cutoff radii.
+		virtual const CutoffList& GetCutoffs() const override { return _rc; }
+
 		virtual void Serialize(Json::Value& json) const override
 		{
 			json["type"] = "GayBerne"; 
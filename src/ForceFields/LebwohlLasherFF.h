@@ -20,8 +20,19 @@ namespace SAPHRON
 
 		inline virtual Interaction Evaluate(const Particle& p1, 
 											const Particle& p2, 
-											const Position&,
-											unsigned int) const override
+											const Position& rij,
+											unsigned int wid) const override
+		{
+			return EvaluatePair(p1, p2, rij, 0, wid);
+		}
+
+		// Evaluates a pair given its squared distance. Not virtual so 
+		// pair kernels can inline it.
+		inline Interaction EvaluatePair(const Particle& p1, 
+										const Particle& p2, 
+										const Position&,
+										double, 
+										unsigned int) const
 		{
 			auto& n1 = p1.GetDirector();
 			auto& n2 = p2.GetDirector();
@@ -0,0 +1,222 @@
+#include "LennardJonesBatch.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SAPHRON_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace SAPHRON
+{
+	void EvaluateLennardJonesBatchScalar(const LennardJonesBatch& batch,
+	                                     int n,
+	                                     const LennardJonesBatchBox& box,
+	                                     LennardJonesBatchSums& sums)
+	{
+		for(int k = 0; k < n; ++k)
+		{
+			double d[3] = {batch.dx[k], batch.dy[k], batch.dz[k]};
+
+			// Same convention as World::ApplyMinimumImage.
+			for(int i = 0; i < 3; ++i)
+			{
+				if(d[i] > box.hl[i])
+					d[i] -= box.l[i];
+				else if(d[i] < -box.hl[i])
+					d[i] += box.l[i];
+			}
+
+			auto rsq = d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+			if(rsq > batch.rcsq[k])
+				continue;
+
+			auto sr2 = batch.sigsq[k]/rsq;
+			auto sr6 = sr2*sr2*sr2;
+			auto w = 6.0*batch.eps4[k]*(sr6 - 2.0*sr6*sr6)/rsq;
+			sums.energy[k] += batch.eps4[k]*(sr6*sr6 - sr6) - batch.shift[k];
+			sums.xx[k] += w*d[0]*d[0];
+			sums.xy[k] += w*d[0]*d[1];
+			sums.xz[k] += w*d[0]*d[2];
+			sums.yy[k] += w*d[1]*d[1];
+			sums.yz[k] += w*d[1]*d[2];
+			sums.zz[k] += w*d[2]*d[2];
+		}
+	}
+
+#ifdef SAPHRON_X86_KERNELS
+	// Minimum image of four distances.
+	__attribute__((target("avx2,fma")))
+	static inline __m256d MinimumImageAVX2(__m256d d, __m256d l, __m256d hl)
+	{
+		auto nhl = _mm256_sub_pd(_mm256_setzero_pd(), hl);
+		auto up = _mm256_and_pd(_mm256_cmp_pd(d, hl, _CMP_GT_OQ), l);
+		auto down = _mm256_and_pd(_mm256_cmp_pd(d, nhl, _CMP_LT_OQ), l);
+		return _mm256_add_pd(_mm256_sub_pd(d, up), down);
+	}
+
+	__attribute__((target("avx2,fma")))
+	void EvaluateLennardJonesBatchAVX2(const LennardJonesBatch& batch,
+	                                   int n,
+	                                   const LennardJonesBatchBox& box,
+	                                   LennardJonesBatchSums& sums)
+	{
+		const auto one = _mm256_set1_pd(1.0);
+		const auto two = _mm256_set1_pd(2.0);
+		const auto six = _mm256_set1_pd(6.0);
+		const auto lanes = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+		const auto lx = _mm256_set1_pd(box.l[0]), hlx = _mm256_set1_pd(box.hl[0]);
+		const auto ly = _mm256_set1_pd(box.l[1]), hly = _mm256_set1_pd(box.hl[1]);
+		const auto lz = _mm256_set1_pd(box.l[2]), hlz = _mm256_set1_pd(box.hl[2]);
+
+		for(int k = 0; k < n; k += 4)
+		{
+			// Clear lanes past n so stale data cannot propagate.
+			auto valid = _mm256_cmp_pd(_mm256_add_pd(lanes, _mm256_set1_pd(k)),
+			                           _mm256_set1_pd(n), _CMP_LT_OQ);
+			auto dx = _mm256_and_pd(_mm256_load_pd(batch.dx + k), valid);
+			auto dy = _mm256_and_pd(_mm256_load_pd(batch.dy + k), valid);
+			auto dz = _mm256_and_pd(_mm256_load_pd(batch.dz + k), valid);
+			dx = MinimumImageAVX2(dx, lx, hlx);
+			dy = MinimumImageAVX2(dy, ly, hly);
+			dz = MinimumImageAVX2(dz, lz, hlz);
+
+			auto rsq = _mm256_fmadd_pd(dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dz, dz)));
+			auto mask = _mm256_and_pd(valid,
+			            _mm256_cmp_pd(rsq, _mm256_load_pd(batch.rcsq + k), _CMP_LE_OQ));
+			rsq = _mm256_blendv_pd(one, rsq, mask);
+
+			auto inv = _mm256_div_pd(one, rsq);
+			auto sr2 = _mm256_mul_pd(_mm256_load_pd(batch.sigsq + k), inv);
+			auto sr6 = _mm256_mul_pd(_mm256_mul_pd(sr2, sr2), sr2);
+			auto sr12 = _mm256_mul_pd(sr6, sr6);
+			auto eps4 = _mm256_load_pd(batch.eps4 + k);
+
+			auto en = _mm256_sub_pd(_mm256_mul_pd(eps4, _mm256_sub_pd(sr12, sr6)),
+			                        _mm256_load_pd(batch.shift + k));
+			auto w = _mm256_mul_pd(_mm256_mul_pd(six, eps4),
+			         _mm256_mul_pd(_mm256_fnmadd_pd(two, sr12, sr6), inv));
+			en = _mm256_and_pd(en, mask);
+			w = _mm256_and_pd(w, mask);
+
+			auto wx = _mm256_mul_pd(w, dx);
+			auto wy = _mm256_mul_pd(w, dy);
+			auto wz = _mm256_mul_pd(w, dz);
+			_mm256_store_pd(sums.energy + k, _mm256_add_pd(_mm256_load_pd(sums.energy + k), en));
+			_mm256_store_pd(sums.xx + k, _mm256_fmadd_pd(wx, dx, _mm256_load_pd(sums.xx + k)));
+			_mm256_store_pd(sums.xy + k, _mm256_fmadd_pd(wx, dy, _mm256_load_pd(sums.xy + k)));
+			_mm256_store_pd(sums.xz + k, _mm256_fmadd_pd(wx, dz, _mm256_load_pd(sums.xz + k)));
+			_mm256_store_pd(sums.yy + k, _mm256_fmadd_pd(wy, dy, _mm256_load_pd(sums.yy + k)));
+			_mm256_store_pd(sums.yz + k, _mm256_fmadd_pd(wy, dz, _mm256_load_pd(sums.yz + k)));
+			_mm256_store_pd(sums.zz + k, _mm256_fmadd_pd(wz, dz, _mm256_load_pd(sums.zz + k)));
+		}
+	}
+
+	// Minimum image of eight distances.
+	__attribute__((target("avx512f")))
+	static inline __m512d MinimumImageAVX512(__m512d d, __m512d l, __m512d hl)
+	{
+		auto nhl = _mm512_sub_pd(_mm512_setzero_pd(), hl);
+		auto up = _mm512_cmp_pd_mask(d, hl, _CMP_GT_OQ);
+		auto down = _mm512_cmp_pd_mask(d, nhl, _CMP_LT_OQ);
+		d = _mm512_mask_sub_pd(d, up, d, l);
+		return _mm512_mask_add_pd(d, down, d, l);
+	}
+
+	__attribute__((target("avx512f")))
+	void EvaluateLennardJonesBatchAVX512(const LennardJonesBatch& batch,
+	                                     int n,
+	                                     const LennardJonesBatchBox& box,
+	                                     LennardJonesBatchSums& sums)
+	{
+		static_assert(LJ_BATCH_SIZE == 8, "AVX-512 kernel expects batches of 8.");
+		if(n <= 0)
+			return;
+
+		const auto one = _mm512_set1_pd(1.0);
+		const auto two = _mm512_set1_pd(2.0);
+		const auto six = _mm512_set1_pd(6.0);
+
+		// Zero lanes past n so stale data cannot propagate.
+		__mmask8 valid = (n >= 8) ? 0xFF : (__mmask8)((1u << n) - 1);
+		auto dx = _mm512_maskz_load_pd(valid, batch.dx);
+		auto dy = _mm512_maskz_load_pd(valid, batch.dy);
+		auto dz = _mm512_maskz_load_pd(valid, batch.dz);
+		dx = MinimumImageAVX512(dx, _mm512_set1_pd(box.l[0]), _mm512_set1_pd(box.hl[0]));
+		dy = MinimumImageAVX512(dy, _mm512_set1_pd(box.l[1]), _mm512_set1_pd(box.hl[1]));
+		dz = MinimumImageAVX512(dz, _mm512_set1_pd(box.l[2]), _mm512_set1_pd(box.hl[2]));
+
+		auto rsq = _mm512_fmadd_pd(dx, dx, _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dz, dz)));
+		__mmask8 mask = valid & _mm512_cmp_pd_mask(rsq, _mm512_load_pd(batch.rcsq), _CMP_LE_OQ);
+		rsq = _mm512_mask_blend_pd(mask, one, rsq);
+
+		auto inv = _mm512_div_pd(one, rsq);
+		auto sr2 = _mm512_mul_pd(_mm512_maskz_load_pd(valid, batch.sigsq), inv);
+		auto sr6 = _mm512_mul_pd(_mm512_mul_pd(sr2, sr2), sr2);
+		auto sr12 = _mm512_mul_pd(sr6, sr6);
+		auto eps4 = _mm512_maskz_load_pd(valid, batch.eps4);
+
+		auto en = _mm512_maskz_sub_pd(mask, _mm512_mul_pd(eps4, _mm512_sub_pd(sr12, sr6)),
+		                              _mm512_maskz_load_pd(valid, batch.shift));
+		auto w = _mm512_maskz_mul_pd(mask, _mm512_mul_pd(six, eps4),
+		                             _mm512_mul_pd(_mm512_fnmadd_pd(two, sr12, sr6), inv));
+
+		auto wx = _mm512_mul_pd(w, dx);
+		auto wy = _mm512_mul_pd(w, dy);
+		auto wz = _mm512_mul_pd(w, dz);
+		_mm512_store_pd(sums.energy, _mm512_add_pd(_mm512_load_pd(sums.energy), en));
+		_mm512_store_pd(sums.xx, _mm512_fmadd_pd(wx, dx, _mm512_load_pd(sums.xx)));
+		_mm512_store_pd(sums.xy, _mm512_fmadd_pd(wx, dy, _mm512_load_pd(sums.xy)));
+		_mm512_store_pd(sums.xz, _mm512_fmadd_pd(wx, dz, _mm512_load_pd(sums.xz)));
+		_mm512_store_pd(sums.yy, _mm512_fmadd_pd(wy, dy, _mm512_load_pd(sums.yy)));
+		_mm512_store_pd(sums.yz, _mm512_fmadd_pd(wy, dz, _mm512_load_pd(sums.yz)));
+		_mm512_store_pd(sums.zz, _mm512_fmadd_pd(wz, dz, _mm512_load_pd(sums.zz)));
+	}
+
+	bool HasLennardJonesBatchAVX2()
+	{
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	}
+
+	bool HasLennardJonesBatchAVX512()
+	{
+		return __builtin_cpu_supports("avx512f");
+	}
+#else
+	void EvaluateLennardJonesBatchAVX2(const LennardJonesBatch& batch,
+	                                   int n,
+	                                   const LennardJonesBatchBox& box,
+	                                   LennardJonesBatchSums& sums)
+	{
+		EvaluateLennardJonesBatchScalar(batch, n, box, sums);
+	}
+
+	void EvaluateLennardJonesBatchAVX512(const LennardJonesBatch& batch,
+	                                     int n,
+	                                     const LennardJonesBatchBox& box,
+	                                     LennardJonesBatchSums& sums)
+	{
+		EvaluateLennardJonesBatchScalar(batch, n, box, sums);
+	}
+
+	bool HasLennardJonesBatchAVX2() { return false; }
+	bool HasLennardJonesBatchAVX512() { return false; }
+#endif
+
+	LennardJonesBatchKernel GetLennardJonesBatchKernel()
+	{
+		static const LennardJonesBatchKernel kernel =
+			HasLennardJonesBatchAVX512() ? &EvaluateLennardJonesBatchAVX512 :
+			HasLennardJonesBatchAVX2() ? &EvaluateLennardJonesBatchAVX2 :
+			&EvaluateLennardJonesBatchScalar;
+		return kernel;
+	}
+
+	const char* GetLennardJonesBatchKernelName()
+	{
+		auto kernel = GetLennardJonesBatchKernel();
+		if(kernel == &EvaluateLennardJonesBatchAVX512)
+			return "AVX-512";
+		else if(kernel == &EvaluateLennardJonesBatchAVX2)
+			return "AVX2";
+		return "Scalar";
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+namespace SAPHRON
+{
+	// Number of pairs in a Lennard-Jones batch.
+	const int LJ_BATCH_SIZE = 8;
+
+	// Pairs gathered for batched Lennard-Jones evaluation. Distances are
+	// raw coordinate differences; minimum image is applied by the kernel.
+	// Each pair carries its own parameters so batches may mix species.
+	// Pairs beyond rcsq do not contribute.
+	struct alignas(64) LennardJonesBatch
+	{
+		double dx[LJ_BATCH_SIZE];
+		double dy[LJ_BATCH_SIZE];
+		double dz[LJ_BATCH_SIZE];
+		double eps4[LJ_BATCH_SIZE];  // 4*epsilon.
+		double sigsq[LJ_BATCH_SIZE]; // sigma^2.
+		double rcsq[LJ_BATCH_SIZE];  // Cutoff squared.
+		double shift[LJ_BATCH_SIZE]; // Energy shift.
+	};
+
+	// Per-lane sums of energy and virial tensor over batches. Kept
+	// per lane so kernels avoid horizontal sums on every batch.
+	struct alignas(64) LennardJonesBatchSums
+	{
+		double energy[LJ_BATCH_SIZE];
+		double xx[LJ_BATCH_SIZE];
+		double xy[LJ_BATCH_SIZE];
+		double xz[LJ_BATCH_SIZE];
+		double yy[LJ_BATCH_SIZE];
+		double yz[LJ_BATCH_SIZE];
+		double zz[LJ_BATCH_SIZE];
+
+		LennardJonesBatchSums() : 
+		energy(), xx(), xy(), xz(), yy(), yz(), zz() {}
+
+		// Sum over lanes.
+		static double Total(const double* v)
+		{
+			double sum = 0;
+			for(int i = 0; i < LJ_BATCH_SIZE; ++i)
+				sum += v[i];
+			return sum;
+		}
+	};
+
+	// Orthorhombic box for minimum image. Lengths are zero along
+	// non-periodic dimensions.
+	struct LennardJonesBatchBox
+	{
+		double l[3];
+		double hl[3];
+	};
+
+	// Evaluates the first n pairs of a batch and adds them to sums.
+	typedef void (*LennardJonesBatchKernel)(const LennardJonesBatch& batch,
+	                                        int n,
+	                                        const LennardJonesBatchBox& box,
+	                                        LennardJonesBatchSums& sums);
+
+	// Portable scalar kernel.
+	void EvaluateLennardJonesBatchScalar(const LennardJonesBatch& batch,
+	                                     int n,
+	                                     const LennardJonesBatchBox& box,
+	                                     LennardJonesBatchSums& sums);
+
+	// AVX2 kernel. Only call if supported by the CPU.
+	void EvaluateLennardJonesBatchAVX2(const LennardJonesBatch& batch,
+	                                   int n,
+	                                   const LennardJonesBatchBox& box,
+	                                   LennardJonesBatchSums& sums);
+
+	// AVX-512 kernel. Only call if supported by the CPU.
+	void EvaluateLennardJonesBatchAVX512(const LennardJonesBatch& batch,
+	                                     int n,
+	                                     const LennardJonesBatchBox& box,
+	                                     LennardJonesBatchSums& sums);
+
+	// Are the AVX2 and AVX-512 kernels supported by this build and CPU?
+	bool HasLennardJonesBatchAVX2();
+	bool HasLennardJonesBatchAVX512();
+
+	// Gets the fastest kernel supported by the CPU, detected on first call.
+	LennardJonesBatchKernel GetLennardJonesBatchKernel();
+
+	// Gets the name of the kernel returned by GetLennardJonesBatchKernel.
+	const char* GetLennardJonesBatchKernelName();
+}
@@ -40,14 +40,24 @@ namespace SAPHRON
 			}
 		}
 
-		virtual Interaction Evaluate(const Particle&, 
-									 const Particle&, 
+		virtual Interaction Evaluate(const Particle& p1, 
+									 const Particle& p2, 
 									 const Position& rij,
 									 unsigned int wid) const override
+		{
+			return EvaluatePair(p1, p2, rij, fdot(rij, rij), wid);
+		}
+
+		// Evaluates a pair given its squared distance. Not virtual so 
+		// pair kernels can inline it.
+		inline Interaction EvaluatePair(const Particle&, 
+										const Particle&, 
+										const Position&,
+										double rsq, 
+										unsigned int wid) const
 		{
 			Interaction ep;
 
-			auto rsq = fdot(rij, rij);
 			if(rsq > _rcsq[wid])
 				return ep;
 
@@ -68,6 +78,9 @@ namespace SAPHRON
 			return _ptail[wid];
 		}
 
+		// Get cutoff radii.
+		virtual const CutoffList& GetCutoffs() const override { return _rc; }
+
 		// Serialize LJ.
 		virtual void Serialize(Json::Value& json) const override
 		{	
@@ -78,6 +91,16 @@ namespace SAPHRON
 				json["rcut"].append(rc);
 		}
 
+		// Get parameters for batched evaluation in world wid.
+		inline void GetBatchParameters(unsigned int wid, double& eps4, double& sigsq, 
+		                               double& rcsq, double& shift) const
+		{
+			eps4 = 4.0*_epsilon;
+			sigsq = _sigmasq;
+			rcsq = _rcsq[wid];
+			shift = 0;
+		}
+
 		double GetEpsilon() const { return _epsilon; }
 		double GetSigma() const { return sqrt(_sigmasq); }
 	};
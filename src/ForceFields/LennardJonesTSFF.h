@@ -31,14 +31,24 @@ namespace SAPHRON
 			}
 		}
 
-		virtual Interaction Evaluate(const Particle&, 
-									 const Particle&, 
+		virtual Interaction Evaluate(const Particle& p1, 
+									 const Particle& p2, 
 									 const Position& rij,
 									 unsigned int wid) const override
+		{
+			return EvaluatePair(p1, p2, rij, fdot(rij, rij), wid);
+		}
+
+		// Evaluates a pair given its squared distance. Not virtual so 
+		// pair kernels can inline it.
+		inline Interaction EvaluatePair(const Particle&, 
+										const Particle&, 
+										const Position&,
+										double rsq, 
+										unsigned int wid) const
 		{
 			Interaction ep;
 
-			auto rsq = fdot(rij, rij);
 			if(rsq > _rcsq[wid])
 				return ep;
 
@@ -49,6 +59,19 @@ namespace SAPHRON
 			return ep;
 		}
 
+		// Get parameters for batched evaluation in world wid.
+		inline void GetBatchParameters(unsigned int wid, double& eps4, double& sigsq, 
+		                               double& rcsq, double& shift) const
+		{
+			eps4 = 4.0*_epsilon;
+			sigsq = _sigmasq;
+			rcsq = _rcsq[wid];
+			shift = _vrc[wid];
+		}
+
+		// Get cutoff radii.
+		virtual const CutoffList& GetCutoffs() const override { return _rc; }
+
 		// Serialize.
 		virtual void Serialize(Json::Value& json) const override
 		{	
@@ -56,6 +56,9 @@ namespace SAPHRON
 			return ep;
 		}
 
+		// Get cutoff radii.
+		virtual const CutoffList& GetCutoffs() const override { return _rc; }
+
 		// Serialize.
 		virtual void Serialize(Json::Value& json) const override
 		{	
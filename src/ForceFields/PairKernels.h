@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ForceField.h"
+
+namespace SAPHRON
+{
+	// Pair kernel helpers used by ForceFieldManager to instantiate neighbor
+	// loops for specific (non-bonded, electrostatic) forcefield types. A
+	// forcefield supporting kernels provides a non-virtual inline method
+	// EvaluatePair(p1, p2, rij, rsq, wid) taking the squared distance.
+
+	// Placeholder type for an absent forcefield.
+	struct NoForceField {};
+
+	// Evaluates a pair through a forcefield of known type. Resolved at
+	// compile time so the forcefield is inlined into the pair loop.
+	template<typename FF>
+	inline Interaction EvaluateKernel(const FF* ff,
+									  const Particle& p1,
+									  const Particle& p2,
+									  const Position& rij,
+									  double rsq,
+									  unsigned int wid)
+	{
+		return ff->EvaluatePair(p1, p2, rij, rsq, wid);
+	}
+
+	// Generic forcefields fall back on virtual dispatch.
+	inline Interaction EvaluateKernel(const ForceField* ff,
+									  const Particle& p1,
+									  const Particle& p2,
+									  const Position& rij,
+									  double,
+									  unsigned int wid)
+	{
+		return (ff == nullptr) ? Interaction() : ff->Evaluate(p1, p2, rij, wid);
+	}
+
+	// Absent forcefields do not contribute.
+	inline Interaction EvaluateKernel(const NoForceField*,
+									  const Particle&,
+									  const Particle&,
+									  const Position&,
+									  double,
+									  unsigned int)
+	{
+		return Interaction();
+	}
+
+	// Casts a forcefield to the type a kernel was instantiated for.
+	template<typename FF>
+	inline const FF* KernelCast(const ForceField* ff)
+	{
+		return static_cast<const FF*>(ff);
+	}
+
+	template<>
+	inline const NoForceField* KernelCast<NoForceField>(const ForceField*)
+	{
+		return nullptr;
+	}
+}
@@ -0,0 +1,605 @@
+#pragma once
+
+#include "ForceField.h"
+#include "../Particles/Particle.h"
+#include "../Simulation/SimException.h"
+#include "../Simulation/SimInfo.h"
+#include "../Utils/FFT.h"
+#include "../Worlds/World.h"
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace SAPHRON
+{
+	// Smooth particle mesh Ewald, see Essmann et al., J. Chem. Phys. 103,
+	// 8577 (1995). Real space is the same as EwaldFF. Charges are spread on
+	// a mesh with cardinal B-splines and the reciprocal energy is
+	// sum Q(k)*phi(k), where phi = g*Q is the mesh potential of the influence
+	// function G = FFT(g). Particle energies only involve the mesh points
+	// under their splines. Changes to the mesh are kept aside and phi is
+	// refreshed by FFT once correcting for them costs more.
+	//
+	// Worlds that are not periodic along exactly one axis are treated as 
+	// slabs following Yeh and Berkowitz, J. Chem. Phys. 111, 3155 (1999). 
+	// The mesh spans the box extended by the slab factor along that axis, 
+	// and the dipole correction for the remaining images is added, 
+	// including the terms for a net charge of Ballenegger et al., J. Chem. 
+	// Phys. 131, 094107 (2009). The grid then refers to the extended box.
+	class SPMEFF : public ForceField
+	{
+	private:
+		static constexpr int MaxOrder = 16;
+
+		double _alpha;
+		int _kx, _ky, _kz;
+		int _order;
+		CutoffList _rc;
+		double _slab;
+		double _qdim;
+		FFT3D _fft;
+
+		// Squared B-spline moduli along each axis.
+		std::vector<double> _bx, _by, _bz;
+
+		// Influence function of a box shape in k-space (G) and real space (g).
+		struct Influence
+		{
+			double lx, ly, lz;
+			std::vector<double> G, g;
+		};
+
+		// Influence functions of recently used box shapes, most recent first.
+		// Volume moves alternate between few shapes.
+		mutable std::list<Influence> _influence;
+
+		// Charge on a mesh point.
+		struct MeshCharge
+		{
+			int ix, iy, iz;
+			double q;
+		};
+
+		// Charge mesh of a world.
+		struct Mesh
+		{
+			// Box and charge log sequence number Q is up to date with.
+			bool valid = false;
+			double lx = 0, ly = 0, lz = 0;
+			unsigned long seq = 0;
+
+			// Non-periodic axis of a slab (-1 if none) and the box spanned
+			// by the mesh.
+			int axis = -1;
+			double ex = 0, ey = 0, ez = 0;
+
+			// Net charge, dipole and second moment along the slab axis.
+			double qnet = 0, dip = 0, dipsq = 0;
+
+			// Charge mesh and potential mesh as of the last refresh.
+			std::vector<double> Q, phi;
+
+			// Changes to Q since phi was refreshed.
+			std::unordered_map<int, double> pending;
+
+			// Sum of squared charges.
+			double qsq = 0;
+
+			// Scratch.
+			std::vector<MeshCharge> local;
+			std::vector<std::complex<double>> work;
+		};
+
+		// Charge mesh of each world.
+		mutable std::vector<Mesh> _meshes;
+
+		// Sum of squared charges, net charge and moments along the slab axis
+		// of a set of primitives.
+		struct Moments
+		{
+			double qsq = 0, q = 0, dip = 0, dipsq = 0;
+		};
+
+		// Gets the only non-periodic axis of a world, or -1 if it is fully 
+		// periodic. Throws BuildException for worlds that are not supported 
+		// (see IsSupported).
+		static int GetSlabAxis(const World& w)
+		{
+			if(!IsSupported(w))
+				throw BuildException({"SPME supports at most one non-periodic axis (world " + 
+				                      std::to_string(w.GetID()) + ")."});
+
+			bool periodic[3] = {w.GetPeriodicX(), w.GetPeriodicY(), w.GetPeriodicZ()};
+			for(int d = 0; d < 3; ++d)
+				if(!periodic[d])
+					return d;
+			return -1;
+		}
+
+		// Adds charge q at x, y, z to moments along the slab axis, measured
+		// from the center of the box.
+		static void AddMoments(const Mesh& m, double q, double x, double y, double z, Moments& mom)
+		{
+			mom.q += q;
+			if(m.axis < 0)
+				return;
+
+			double c = (m.axis == 0) ? x - 0.5*m.lx : ((m.axis == 1) ? y - 0.5*m.ly : z - 0.5*m.lz);
+			mom.dip += q*c;
+			mom.dipsq += q*c*c;
+		}
+
+		// Slab correction given net charge and moments along the slab axis.
+		static double SlabEnergy(const Mesh& m, double q, double dip, double dipsq)
+		{
+			if(m.axis < 0)
+				return 0;
+
+			double l = (m.axis == 0) ? m.ex : ((m.axis == 1) ? m.ey : m.ez);
+			return 2.*M_PI/(m.ex*m.ey*m.ez)*(dip*dip - q*dipsq - q*q*l*l/12.);
+		}
+
+		// Slab correction of a mesh with moments mom added.
+		static double SlabEnergy(const Mesh& m, const Moments& mom)
+		{
+			return SlabEnergy(m, m.qnet + mom.q, m.dip + mom.dip, m.dipsq + mom.dipsq);
+		}
+
+		// Fills c[j] = M_n(w + j), j = 0..n-1, for cardinal B-spline of order n.
+		static void BSpline(double w, int n, double* c)
+		{
+			c[0] = w;
+			c[1] = 1. - w;
+			for(int p = 3; p <= n; ++p)
+			{
+				c[p-1] = 0;
+				for(int j = p - 1; j >= 0; --j)
+					c[j] = ((w + j)*c[j] + (p - w - j)*(j > 0 ? c[j-1] : 0.))/(p - 1);
+			}
+		}
+
+		// Squared moduli |b(m)|^2 of the B-spline Euler exponential spline.
+		// Zeros (odd orders at the Nyquist frequency) are interpolated.
+		static std::vector<double> Moduli(int K, int n)
+		{
+			double c[MaxOrder];
+			BSpline(0., n, c);
+
+			std::vector<double> b(K);
+			for(int m = 0; m < K; ++m)
+			{
+				double re = 0, im = 0;
+				for(int k = 0; k < n - 1; ++k)
+				{
+					re += c[k+1]*std::cos(2.*M_PI*m*k/K);
+					im += c[k+1]*std::sin(2.*M_PI*m*k/K);
+				}
+				auto d = re*re + im*im;
+				b[m] = d > 1e-10 ? 1./d : 0.;
+			}
+
+			for(int m = 0; m < K; ++m)
+				if(b[m] == 0)
+					b[m] = 0.5*(b[(m + K - 1) % K] + b[(m + 1) % K]);
+
+			return b;
+		}
+
+		inline int Index(int ix, int iy, int iz) const
+		{
+			return (ix*_ky + iy)*_kz + iz;
+		}
+
+		// Gets the real space influence function between two mesh points.
+		inline double Kernel(const Influence& inf, const MeshCharge& a, const MeshCharge& b) const
+		{
+			auto dx = a.ix - b.ix, dy = a.iy - b.iy, dz = a.iz - b.iz;
+			if(dx < 0) dx += _kx;
+			if(dy < 0) dy += _ky;
+			if(dz < 0) dz += _kz;
+			return inf.g[Index(dx, dy, dz)];
+		}
+
+		// Gets the first mesh index below scaled coordinate u of an axis
+		// with K points and fills the spline weights of the n points below.
+		int Split(double u, int K, double* c) const
+		{
+			u -= K*std::floor(u/K);
+			if(u >= K)
+				u -= K;
+			auto b = (int)u;
+			BSpline(u - b, _order, c);
+			return b;
+		}
+
+		// Spreads charge q at x, y, z over the mesh points of its splines.
+		void Spread(const Mesh& m, double q, double x, double y, double z,
+		            std::vector<MeshCharge>& out) const
+		{
+			double cx[MaxOrder], cy[MaxOrder], cz[MaxOrder];
+			auto bx = Split(x/m.ex*_kx, _kx, cx);
+			auto by = Split(y/m.ey*_ky, _ky, cy);
+			auto bz = Split(z/m.ez*_kz, _kz, cz);
+
+			for(int i = 0; i < _order; ++i)
+			{
+				auto ix = (bx - i < 0) ? bx - i + _kx : bx - i;
+				for(int j = 0; j < _order; ++j)
+				{
+					auto iy = (by - j < 0) ? by - j + _ky : by - j;
+					auto qxy = q*cx[i]*cy[j];
+					for(int k = 0; k < _order; ++k)
+					{
+						auto iz = (bz - k < 0) ? bz - k + _kz : bz - k;
+						out.push_back(MeshCharge{ix, iy, iz, qxy*cz[k]});
+					}
+				}
+			}
+		}
+
+		// Merges mesh charges on the same point.
+		void Compact(std::vector<MeshCharge>& v) const
+		{
+			std::sort(v.begin(), v.end(), [this](const MeshCharge& a, const MeshCharge& b) {
+				return Index(a.ix, a.iy, a.iz) < Index(b.ix, b.iy, b.iz);
+			});
+
+			size_t n = 0;
+			for(size_t i = 0; i < v.size(); ++i)
+			{
+				if(n > 0 && v[n-1].ix == v[i].ix && v[n-1].iy == v[i].iy && v[n-1].iz == v[i].iz)
+					v[n-1].q += v[i].q;
+				else
+					v[n++] = v[i];
+			}
+			v.resize(n);
+		}
+
+		// Spreads the primitives of a particle displaced by dr and adds their
+		// charges to moments.
+		void AddParticle(const Mesh& m, const Particle& particle, const Position& dr, double sign,
+		                 std::vector<MeshCharge>& out, Moments& mom) const
+		{
+			if(particle.HasChildren())
+			{
+				for(auto& child : particle)
+					AddParticle(m, *child, dr, sign, out, mom);
+				return;
+			}
+
+			auto q = particle.GetCharge();
+			if(q == 0)
+				return;
+
+			auto& x = particle.GetPosition();
+			Spread(m, sign*q, x[0] + dr[0], x[1] + dr[1], x[2] + dr[2], out);
+			AddMoments(m, sign*q, x[0] + dr[0], x[1] + dr[1], x[2] + dr[2], mom);
+			mom.qsq += q*q;
+		}
+
+		// Gets the influence function of a box shape.
+		const Influence& GetInfluence(double lx, double ly, double lz) const
+		{
+			for(auto it = _influence.begin(); it != _influence.end(); ++it)
+				if(it->lx == lx && it->ly == ly && it->lz == lz)
+				{
+					_influence.splice(_influence.begin(), _influence, it);
+					return _influence.front();
+				}
+
+			int n = _fft.GetSize();
+			Influence inf{lx, ly, lz, std::vector<double>(n, 0.), std::vector<double>(n)};
+
+			double coeff = 0.5/(M_PI*lx*ly*lz);
+			for(int i = 0; i < _kx; ++i)
+				for(int j = 0; j < _ky; ++j)
+					for(int k = 0; k < _kz; ++k)
+					{
+						if(i == 0 && j == 0 && k == 0)
+							continue;
+
+						double hx = (i <= _kx/2 ? i : i - _kx)/lx;
+						double hy = (j <= _ky/2 ? j : j - _ky)/ly;
+						double hz = (k <= _kz/2 ? k : k - _kz)/lz;
+						double hsq = hx*hx + hy*hy + hz*hz;
+						inf.G[Index(i, j, k)] = coeff/hsq*std::exp(-M_PI*M_PI*hsq/(_alpha*_alpha))*
+						                        _bx[i]*_by[j]*_bz[k];
+					}
+
+			std::vector<std::complex<double>> work(inf.G.begin(), inf.G.end());
+			_fft.Inverse(work);
+			for(int i = 0; i < n; ++i)
+				inf.g[i] = work[i].real();
+
+			_influence.push_front(std::move(inf));
+			if(_influence.size() > 4)
+				_influence.pop_back();
+
+			return _influence.front();
+		}
+
+		// Recomputes the potential mesh phi = g*Q.
+		void Refresh(Mesh& m, const Influence& inf) const
+		{
+			int n = _fft.GetSize();
+			m.work.assign(m.Q.begin(), m.Q.end());
+			_fft.Forward(m.work);
+			for(int i = 0; i < n; ++i)
+				m.work[i] *= inf.G[i];
+			_fft.Inverse(m.work);
+
+			m.phi.resize(n);
+			for(int i = 0; i < n; ++i)
+				m.phi[i] = m.work[i].real();
+			m.pending.clear();
+		}
+
+		// Rebuilds the charge and potential mesh of a world.
+		void Rebuild(const World& w, Mesh& m) const
+		{
+			auto& H = w.GetHMatrix();
+			m.lx = H(0,0);
+			m.ly = H(1,1);
+			m.lz = H(2,2);
+
+			// Mesh spans the extended box of slabs.
+			m.axis = GetSlabAxis(w);
+			m.ex = (m.axis == 0) ? _slab*m.lx : m.lx;
+			m.ey = (m.axis == 1) ? _slab*m.ly : m.ly;
+			m.ez = (m.axis == 2) ? _slab*m.lz : m.lz;
+
+			auto& soa = w.GetPrimitiveArrays();
+			m.Q.assign(_fft.GetSize(), 0);
+			m.qsq = 0;
+			Moments mom;
+			for(int i = 0; i < w.GetPrimitiveCount(); ++i)
+			{
+				if(soa.q[i] == 0)
+					continue;
+
+				m.local.clear();
+				Spread(m, soa.q[i], soa.x[i], soa.y[i], soa.z[i], m.local);
+				for(auto& c : m.local)
+					m.Q[Index(c.ix, c.iy, c.iz)] += c.q;
+				AddMoments(m, soa.q[i], soa.x[i], soa.y[i], soa.z[i], mom);
+				m.qsq += soa.q[i]*soa.q[i];
+			}
+			m.qnet = mom.q;
+			m.dip = mom.dip;
+			m.dipsq = mom.dipsq;
+
+			Refresh(m, GetInfluence(m.ex, m.ey, m.ez));
+			m.seq = w.GetChargeLogStart() + w.GetChargeLog().size();
+			m.valid = true;
+		}
+
+		// Gets the mesh of a world, replaying logged charge changes. It is
+		// rebuilt if the box changed or the log was dropped.
+		Mesh& Sync(const World& w) const
+		{
+			auto wid = w.GetID();
+			if((int)_meshes.size() <= wid)
+				_meshes.resize(wid + 1);
+
+			auto& m = _meshes[wid];
+			w.TrackChargeChanges();
+
+			auto& H = w.GetHMatrix();
+			auto& log = w.GetChargeLog();
+			auto start = w.GetChargeLogStart();
+			if(!m.valid || m.seq < start || m.axis != GetSlabAxis(w) || 
+			   m.lx != H(0,0) || m.ly != H(1,1) || m.lz != H(2,2))
+			{
+				Rebuild(w, m);
+				return m;
+			}
+
+			if(m.seq == start + log.size())
+				return m;
+
+			m.local.clear();
+			Moments mom;
+			for(auto k = m.seq - start; k < log.size(); ++k)
+			{
+				auto& c = log[k];
+				if(c.qold != 0)
+				{
+					Spread(m, -c.qold, c.rold[0], c.rold[1], c.rold[2], m.local);
+					AddMoments(m, -c.qold, c.rold[0], c.rold[1], c.rold[2], mom);
+				}
+				if(c.qnew != 0)
+				{
+					Spread(m, c.qnew, c.rnew[0], c.rnew[1], c.rnew[2], m.local);
+					AddMoments(m, c.qnew, c.rnew[0], c.rnew[1], c.rnew[2], mom);
+				}
+				m.qsq += c.qnew*c.qnew - c.qold*c.qold;
+			}
+			m.seq = start + log.size();
+			m.qnet += mom.q;
+			m.dip += mom.dip;
+			m.dipsq += mom.dipsq;
+
+			for(auto& c : m.local)
+			{
+				auto i = Index(c.ix, c.iy, c.iz);
+				m.Q[i] += c.q;
+				m.pending[i] += c.q;
+			}
+
+			// Correcting a stencil for pending changes costs order^3 per change,
+			// a refresh about n*log2(n) for n mesh points.
+			double n = _fft.GetSize();
+			if(m.pending.size()*std::pow(_order, 3) > n*std::log2(n))
+				Refresh(m, GetInfluence(m.ex, m.ey, m.ez));
+
+			return m;
+		}
+
+		// Gets the sum of q*phi over mesh charges, with phi corrected for
+		// pending changes.
+		double Potential(const Mesh& m, const Influence& inf, const std::vector<MeshCharge>& a) const
+		{
+			double u = 0;
+			for(auto& c : a)
+				u += c.q*m.phi[Index(c.ix, c.iy, c.iz)];
+
+			int kyz = _ky*_kz;
+			for(auto& p : m.pending)
+			{
+				MeshCharge b{p.first/kyz, (p.first % kyz)/_kz, p.first % _kz, p.second};
+				for(auto& c : a)
+					u += c.q*b.q*Kernel(inf, c, b);
+			}
+
+			return u;
+		}
+
+		// Gets the mesh energy of mesh charges with themselves.
+		double SelfPotential(const Influence& inf, const std::vector<MeshCharge>& a) const
+		{
+			double u = 0;
+			for(auto& c1 : a)
+				for(auto& c2 : a)
+					u += c1.q*c2.q*Kernel(inf, c1, c2);
+
+			return u;
+		}
+
+	public:
+		SPMEFF(double alpha, int kx, int ky, int kz, int order, const CutoffList& rc, double slab = 3.) :
+		_alpha(alpha), _kx(kx), _ky(ky), _kz(kz), _order(order), _rc(rc), _slab(slab),
+		_fft(kx, ky, kz), _bx(Moduli(kx, order)), _by(Moduli(ky, order)), _bz(Moduli(kz, order)),
+		_influence(), _meshes()
+		{
+			auto& sim = SimInfo::Instance();
+			_qdim = sim.GetChargeConv();
+		}
+
+		// Can the reciprocal space of a world be evaluated? Worlds must be 
+		// periodic in at least two directions, a single non-periodic axis 
+		// is treated as a slab.
+		static bool IsSupported(const World& w)
+		{
+			return !w.GetPeriodicX() + !w.GetPeriodicY() + !w.GetPeriodicZ() <= 1;
+		}
+
+		Interaction Evaluate(const Particle& p1,
+							const Particle& p2,
+							const Position& rij,
+							unsigned int wid) const override
+		{
+			return EvaluatePair(p1, p2, rij, fdot(rij, rij), wid);
+		}
+
+		// Evaluates a pair given its squared distance. Not virtual so
+		// pair kernels can inline it.
+		inline Interaction EvaluatePair(const Particle& p1,
+										const Particle& p2,
+										const Position&,
+										double rsq,
+										unsigned int wid) const
+		{
+			Interaction ep;
+			auto r = sqrt(rsq);
+
+			if(r > _rc[wid])
+				return ep;
+
+			auto q1 = p1.GetCharge();
+			auto q2 = p2.GetCharge();
+			auto erfcr = std::erfc(_alpha*r);
+			ep.energy = _qdim*q1*q2*erfcr/r;
+
+			if(p1.HasParent() && p2.HasParent() && p1.GetParent() == p2.GetParent())
+				ep.energy -= _qdim*q1*q2*(1.-erfcr)/r;
+
+			return ep;
+		}
+
+		double ReciprocalSpace(const World& w) const override
+		{
+			auto& m = Sync(w);
+			if(!m.pending.empty())
+				Refresh(m, GetInfluence(m.ex, m.ey, m.ez));
+
+			double u = 0;
+			for(size_t i = 0; i < m.Q.size(); ++i)
+				u += m.Q[i]*m.phi[i];
+			u -= _alpha/std::sqrt(M_PI)*m.qsq;
+			u += SlabEnergy(m, Moments());
+
+			return _qdim*u;
+		}
+
+		// Share of a particle in the reciprocal space energy, i.e. the
+		// energy removed along with it including its self term.
+		double ReciprocalSpace(const Particle& particle) const override
+		{
+			auto* w = particle.GetWorld();
+			if(w == nullptr)
+				return 0;
+
+			auto& m = Sync(*w);
+			m.local.clear();
+
+			// Spread with negative charges so moments are those removed.
+			Moments mom;
+			AddParticle(m, particle, {0, 0, 0}, -1., m.local, mom);
+			if(mom.qsq == 0)
+				return 0;
+
+			Compact(m.local);
+			auto& inf = GetInfluence(m.ex, m.ey, m.ez);
+			double u = -2.*Potential(m, inf, m.local) - SelfPotential(inf, m.local);
+			u -= _alpha/std::sqrt(M_PI)*mom.qsq;
+			u += SlabEnergy(m, Moments()) - SlabEnergy(m, mom);
+
+			return _qdim*u;
+		}
+
+		// Change in reciprocal space energy if a particle is displaced by dr.
+		double ReciprocalDelta(const Particle& particle, const Position& dr) const override
+		{
+			auto* w = particle.GetWorld();
+			if(w == nullptr)
+				return 0;
+
+			auto& m = Sync(*w);
+			m.local.clear();
+
+			Moments mom;
+			AddParticle(m, particle, dr, 1., m.local, mom);
+			AddParticle(m, particle, {0, 0, 0}, -1., m.local, mom);
+			if(mom.qsq == 0)
+				return 0;
+
+			Compact(m.local);
+			auto& inf = GetInfluence(m.ex, m.ey, m.ez);
+			double u = 2.*Potential(m, inf, m.local) + SelfPotential(inf, m.local);
+			u += SlabEnergy(m, mom) - SlabEnergy(m, Moments());
+
+			return _qdim*u;
+		}
+
+		// Get cutoff radii.
+		virtual const CutoffList& GetCutoffs() const override { return _rc; }
+
+		// Serialize SPME.
+		void Serialize(Json::Value& json) const override
+		{
+			json["type"] = "SPME";
+			json["alpha"] = _alpha;
+			json["grid"].append(_kx);
+			json["grid"].append(_ky);
+			json["grid"].append(_kz);
+			json["order"] = _order;
+			json["slab_factor"] = _slab;
+			for(auto& rc : _rc)
+				json["rcut"].append(rc);
+		}
+
+		double GetAlpha() const { return _alpha; }
+	};
+}
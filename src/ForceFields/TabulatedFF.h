@@ -0,0 +1,244 @@
+#pragma once
+
+#include "ForceField.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+namespace SAPHRON
+{
+	// Wrapper tabulating a radial forcefield on a uniform grid in r^2. Energy
+	// and virial are evaluated by cubic Hermite interpolation. A table is built
+	// for each world cutoff, spanning [rmin, rc]. Pairs outside of the table
+	// are passed on to the wrapped forcefield. Charged forcefields are tabulated
+	// per unit charge and scaled by q1*q2. Their intramolecular pairs are always
+	// evaluated exactly since they may be treated differently (e.g. Ewald).
+	class TabulatedFF : public ForceField
+	{
+	private:
+		// Cubic coefficients of energy and virial on a grid interval.
+		struct Segment
+		{
+			double e[4];
+			double v[4];
+		};
+
+		struct Table
+		{
+			double rminsq;
+			double rmaxsq;
+			double invh;
+			std::vector<Segment> segments;
+		};
+
+		std::unique_ptr<ForceField> _ff;
+		std::vector<Table> _tables;
+		int _points;
+		double _rmin;
+		double _rmax;
+		bool _charged;
+
+		// Maximum absolute interpolation errors.
+		double _emax;
+		double _vmax;
+
+		// Build table spanning [rmin, rmax] for world wid.
+		void BuildTable(const Particle& p1,
+						const Particle& p2,
+						double rmin,
+						double rmax,
+						unsigned int wid)
+		{
+			Table t;
+			t.rminsq = rmin*rmin;
+			t.rmaxsq = rmax*rmax;
+			auto h = (t.rmaxsq - t.rminsq)/(_points - 1);
+			t.invh = 1.0/h;
+
+			// Scale to unit charges.
+			auto scale = _charged ? 1.0/(p1.GetCharge()*p2.GetCharge()) : 1.0;
+			auto sample = [&](double rsq) {
+				auto ep = _ff->Evaluate(p1, p2, {sqrt(rsq), 0, 0}, wid);
+				ep.energy *= scale;
+				ep.virial *= scale;
+				return ep;
+			};
+
+			// Values and derivatives with respect to r^2 on nodes by second
+			// order finite differences. These are one sided at the ends since 
+			// the forcefield may be discontinuous at the cutoff.
+			std::vector<Interaction> f(_points), df(_points);
+			auto d = 1e-2*h;
+			for(int i = 0; i < _points; ++i)
+			{
+				auto rsq = t.rminsq + i*h;
+				f[i] = sample(rsq);
+				if(i == 0 || i == _points - 1)
+				{
+					auto dd = (i == 0) ? d : -d;
+					auto f1 = sample(rsq + dd), f2 = sample(rsq + 2.0*dd);
+					df[i].energy = (-3.0*f[i].energy + 4.0*f1.energy - f2.energy)/(2.0*dd);
+					df[i].virial = (-3.0*f[i].virial + 4.0*f1.virial - f2.virial)/(2.0*dd);
+				}
+				else
+				{
+					auto lo = sample(rsq - d), hi = sample(rsq + d);
+					df[i].energy = (hi.energy - lo.energy)/(2.0*d);
+					df[i].virial = (hi.virial - lo.virial)/(2.0*d);
+				}
+			}
+
+			auto hermite = [h](double f0, double f1, double d0, double d1, double* c) {
+				auto m0 = h*d0, m1 = h*d1;
+				c[0] = f0;
+				c[1] = m0;
+				c[2] = 3.0*(f1 - f0) - 2.0*m0 - m1;
+				c[3] = 2.0*(f0 - f1) + m0 + m1;
+			};
+
+			t.segments.resize(_points - 1);
+			for(int i = 0; i < _points - 1; ++i)
+			{
+				auto& s = t.segments[i];
+				hermite(f[i].energy, f[i+1].energy, df[i].energy, df[i+1].energy, s.e);
+				hermite(f[i].virial, f[i+1].virial, df[i].virial, df[i+1].virial, s.v);
+
+				// Interpolation error is largest near the middle of an interval.
+				auto ep = sample(t.rminsq + (i + 0.5)*h);
+				_emax = std::max(_emax, std::abs(Interpolate(s.e, 0.5) - ep.energy));
+				_vmax = std::max(_vmax, std::abs(Interpolate(s.v, 0.5) - ep.virial));
+			}
+
+			_tables.push_back(t);
+		}
+
+		static inline double Interpolate(const double* c, double u)
+		{
+			return ((c[3]*u + c[2])*u + c[1])*u + c[0];
+		}
+
+	public:
+		// Tabulates forcefield ff, which the wrapper takes ownership of, using
+		// probe particles p1 and p2. Charged forcefields require charged probes.
+		// The table spans [rmin, rmax] where rmax defaults to the cutoff of each
+		// world and rmin defaults to rmax/4. A forcefield without cutoffs
+		// requires rmax.
+		TabulatedFF(ForceField* ff,
+					const Particle& p1,
+					const Particle& p2,
+					int points,
+					bool charged,
+					double rmin = 0,
+					double rmax = 0) :
+		_ff(ff), _tables(0), _points(points), _rmin(rmin), _rmax(rmax),
+		_charged(charged), _emax(0), _vmax(0)
+		{
+			assert(points >= 2);
+			assert(!charged || p1.GetCharge()*p2.GetCharge() != 0);
+
+			auto& rc = _ff->GetCutoffs();
+			assert(rc.size() || rmax > 0);
+
+			// Forcefields without cutoffs share one table.
+			auto n = std::max(rc.size(), (size_t)1);
+			for(size_t i = 0; i < n; ++i)
+			{
+				auto hi = rc.size() ? rc[i] : rmax;
+				if(rmax > 0)
+					hi = std::min(hi, rmax);
+				auto lo = (rmin > 0) ? rmin : 0.25*hi;
+				BuildTable(p1, p2, lo, hi, i);
+			}
+		}
+
+		virtual Interaction Evaluate(const Particle& p1,
+									 const Particle& p2,
+									 const Position& rij,
+									 unsigned int wid) const override
+		{
+			return EvaluatePair(p1, p2, rij, fdot(rij, rij), wid);
+		}
+
+		// Evaluates a pair given its squared distance. Not virtual so
+		// pair kernels can inline it.
+		inline Interaction EvaluatePair(const Particle& p1,
+										const Particle& p2,
+										const Position& rij,
+										double rsq,
+										unsigned int wid) const
+		{
+			auto& t = _tables[std::min((size_t)wid, _tables.size() - 1)];
+			if(rsq < t.rminsq || rsq > t.rmaxsq ||
+			   (_charged && p1.HasParent() && p1.GetParent() == p2.GetParent()))
+				return _ff->Evaluate(p1, p2, rij, wid);
+
+			auto x = (rsq - t.rminsq)*t.invh;
+			auto i = std::min((size_t)x, t.segments.size() - 1);
+			auto u = x - i;
+			auto& s = t.segments[i];
+			auto scale = _charged ? p1.GetCharge()*p2.GetCharge() : 1.0;
+
+			Interaction ep;
+			ep.energy = scale*Interpolate(s.e, u);
+			ep.virial = scale*Interpolate(s.v, u);
+			return ep;
+		}
+
+		virtual double EnergyTailCorrection(unsigned int wid) const override
+		{
+			return _ff->EnergyTailCorrection(wid);
+		}
+
+		virtual double PressureTailCorrection(unsigned int wid) const override
+		{
+			return _ff->PressureTailCorrection(wid);
+		}
+
+		virtual double ReciprocalSpace(const World& world) const override
+		{
+			return _ff->ReciprocalSpace(world);
+		}
+
+		virtual double ReciprocalSpace(const Particle& particle) const override
+		{
+			return _ff->ReciprocalSpace(particle);
+		}
+
+		virtual double ReciprocalDelta(const Particle& particle, const Position& dr) const override
+		{
+			return _ff->ReciprocalDelta(particle, dr);
+		}
+
+		// Get cutoff radii of the wrapped forcefield.
+		virtual const CutoffList& GetCutoffs() const override
+		{
+			return _ff->GetCutoffs();
+		}
+
+		// Get the wrapped forcefield.
+		const ForceField* GetForceField() const { return _ff.get(); }
+
+		// Get the number of grid points per table.
+		int GetPoints() const { return _points; }
+
+		// Get the maximum absolute energy error found on build.
+		// Charged forcefields report it per unit charge.
+		double GetMaxEnergyError() const { return _emax; }
+
+		// Get the maximum absolute virial error found on build.
+		// Charged forcefields report it per unit charge.
+		double GetMaxVirialError() const { return _vmax; }
+
+		// Serialize wrapped forcefield and table.
+		virtual void Serialize(Json::Value& json) const override
+		{
+			_ff->Serialize(json);
+			json["tabulate"]["points"] = _points;
+			if(_rmin > 0)
+				json["tabulate"]["rmin"] = _rmin;
+			if(_rmax > 0)
+				json["tabulate"]["rmax"] = _rmax;
+		}
+	};
+}
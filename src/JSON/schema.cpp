@@ -16,21 +16,21 @@ namespace SAPHRON
 	std::string SAPHRON::JsonSchema::Histogram = "{\"additionalProperties\": false, \"required\": [\"min\", \"max\"], \"type\": \"object\", \"properties\": {\"min\": {\"type\": \"number\"}, \"bincount\": {\"minimum\": 1, \"type\": \"integer\"}, \"max\": {\"type\": \"number\"}, \"values\": {\"items\": {\"type\": \"number\"}, \"type\": \"array\"}, \"binwidth\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"counts\": {\"items\": {\"minimum\": 0, \"type\": \"integer\"}, \"type\": \"array\"}}}";
 	std::string SAPHRON::JsonSchema::Simulation = "{\"required\": [\"simtype\", \"iterations\"], \"type\": \"object\", \"properties\": {\"units\": {\"enum\": [\"real\", \"reduced\"], \"type\": \"string\"}, \"simtype\": {\"enum\": [\"standard\", \"DOS\"], \"type\": \"string\"}, \"iterations\": {\"minimum\": 1, \"type\": \"integer\"}, \"mpi\": {\"minimum\": 1, \"type\": \"integer\"}}}";
 	std::string SAPHRON::JsonSchema::DOSSimulation = "{\"additionalProperties\": false, \"type\": \"object\", \"properties\": {\"sync_frequency\": {\"minimum\": 0, \"type\": \"integer\"}, \"target_flatness\": {\"exclusiveMinimum\": true, \"exclusiveMaximum\": true, \"minimum\": 0, \"type\": \"number\", \"maximum\": 1}, \"reset_freq\": {\"minimum\": 0, \"type\": \"integer\"}, \"convergence_factor\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"equilibration\": {\"minimum\": 0, \"type\": \"integer\"}}}";
-	std::string SAPHRON::JsonSchema::ModLennardJonesTSFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"sigma\", \"epsilon\", \"beta\", \"species\", \"rcut\"], \"type\": \"object\", \"properties\": {\"type\": {\"enum\": [\"ModLennardJonesTS\"], \"type\": \"string\"}, \"rcut\": {\"minItems\": 1, \"items\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": \"array\"}, \"beta\": {\"type\": \"number\"}, \"epsilon\": {\"minimum\": 0, \"type\": \"number\"}, \"sigma\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}}}";
-	std::string SAPHRON::JsonSchema::LennardJonesTSFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"sigma\", \"epsilon\", \"species\", \"rcut\"], \"type\": \"object\", \"properties\": {\"sigma\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"LennardJonesTS\"], \"type\": \"string\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}, \"rcut\": {\"minItems\": 1, \"items\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": \"array\"}, \"epsilon\": {\"minimum\": 0, \"type\": \"number\"}}}";
-	std::string SAPHRON::JsonSchema::LennardJonesFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"sigma\", \"epsilon\", \"species\", \"rcut\"], \"type\": \"object\", \"properties\": {\"sigma\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"LennardJones\"], \"type\": \"string\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}, \"rcut\": {\"minItems\": 1, \"items\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": \"array\"}, \"epsilon\": {\"minimum\": 0, \"type\": \"number\"}}}";
+	std::string SAPHRON::JsonSchema::ModLennardJonesTSFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"ModLennardJonesTS\"]}, \"sigma\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"epsilon\": {\"type\": \"number\", \"minimum\": 0}, \"beta\": {\"type\": \"number\"}, \"rcut\": {\"type\": \"array\", \"items\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"minItems\": 1}, \"species\": {\"type\": \"array\", \"minItems\": 2, \"maxItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\", \"sigma\", \"epsilon\", \"beta\", \"species\", \"rcut\"]}";
+	std::string SAPHRON::JsonSchema::LennardJonesTSFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"LennardJonesTS\"]}, \"sigma\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"epsilon\": {\"type\": \"number\", \"minimum\": 0}, \"rcut\": {\"type\": \"array\", \"items\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"minItems\": 1}, \"species\": {\"type\": \"array\", \"minItems\": 2, \"maxItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\", \"sigma\", \"epsilon\", \"species\", \"rcut\"]}";
+	std::string SAPHRON::JsonSchema::LennardJonesFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"LennardJones\"]}, \"sigma\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"epsilon\": {\"type\": \"number\", \"minimum\": 0}, \"rcut\": {\"type\": \"array\", \"items\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"minItems\": 1}, \"species\": {\"type\": \"array\", \"minItems\": 2, \"maxItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\", \"sigma\", \"epsilon\", \"species\", \"rcut\"]}";
 	std::string SAPHRON::JsonSchema::LebwohlLasherFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"epsilon\", \"gamma\", \"species\"], \"type\": \"object\", \"properties\": {\"epsilon\": {\"type\": \"number\"}, \"type\": {\"enum\": [\"LebwohlLasher\"], \"type\": \"string\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}, \"gamma\": {\"type\": \"number\"}}}";
 	std::string SAPHRON::JsonSchema::KernFrenkelFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"epsilon\", \"sigma\", \"delta\", \"thetas\", \"pjs\", \"species\", \"invert\"], \"type\": \"object\", \"properties\": {\"thetas\": {\"items\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": \"array\"}, \"epsilon\": {\"minimum\": 0, \"type\": \"number\"}, \"invert\": {\"type\": \"boolean\"}, \"sigma\": {\"minimum\": 0, \"type\": \"number\"}, \"delta\": {\"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"KernFrenkel\"], \"type\": \"string\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}, \"pjs\": {\"items\": {\"additionalItems\": false, \"minItems\": 3, \"varname\": \"Director\", \"maxItems\": 3, \"items\": {\"type\": \"number\"}, \"type\": \"array\"}, \"type\": \"array\"}}}";
-	std::string SAPHRON::JsonSchema::HarmonicFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"kspring\", \"ro\", \"species\"], \"type\": \"object\", \"properties\": {\"ro\": {\"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"Harmonic\"], \"type\": \"string\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}, \"kspring\": {\"minimum\": 0, \"type\": \"number\"}}}";
+	std::string SAPHRON::JsonSchema::HarmonicFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"Harmonic\"]}, \"kspring\": {\"type\": \"number\", \"minimum\": 0}, \"ro\": {\"type\": \"number\", \"minimum\": 0}, \"species\": {\"type\": \"array\", \"minItems\": 2, \"maxItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\", \"kspring\", \"ro\", \"species\"]}";
 	std::string SAPHRON::JsonSchema::HardSphereFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"sigma\", \"species\"], \"type\": \"object\", \"properties\": {\"sigma\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"HardSphere\"], \"type\": \"string\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}}}";
 	std::string SAPHRON::JsonSchema::GayBerneFF = "{\"required\": [\"type\", \"diameters\", \"lengths\", \"eps0\", \"epsE\", \"epsS\", \"rcut\", \"species\"], \"type\": \"object\", \"properties\": {\"diameters\": {\"items\": [{\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}], \"type\": \"array\"}, \"lengths\": {\"items\": [{\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}], \"type\": \"array\"}, \"epsE\": {\"minimum\": 0, \"type\": \"number\"}, \"rcut\": {\"minItems\": 1, \"items\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": \"array\"}, \"nu\": {\"type\": \"number\"}, \"mu\": {\"type\": \"number\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}, \"dw\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"GayBerne\"], \"type\": \"string\"}, \"epsS\": {\"minimum\": 0, \"type\": \"number\"}, \"eps0\": {\"minimum\": 0, \"type\": \"number\"}}}";
-	std::string SAPHRON::JsonSchema::ForceFields = "{\"additionalProperties\": false, \"type\": \"object\", \"properties\": {\"electrostatic\": {\"type\": \"object\"}, \"nonbonded\": {\"type\": \"array\"}, \"bonded\": {\"type\": \"array\"}, \"constraints\": {\"type\": \"array\"}}}";
-	std::string SAPHRON::JsonSchema::FENEFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"epsilon\", \"sigma\", \"kspring\", \"rmax\", \"species\"], \"type\": \"object\", \"properties\": {\"epsilon\": {\"type\": \"number\"}, \"rmax\": {\"minimum\": 0, \"type\": \"number\"}, \"sigma\": {\"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"FENE\"], \"type\": \"string\"}, \"species\": {\"minItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false, \"type\": \"array\", \"maxItems\": 2}, \"kspring\": {\"minimum\": 0, \"type\": \"number\"}}}";
-	std::string SAPHRON::JsonSchema::EwaldFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"alpha\", \"rcut\", \"kmax\"], \"type\": \"object\", \"properties\": {\"alpha\": {\"minimum\": 0, \"type\": \"number\"}, \"kmax\": {\"minItems\": 3, \"items\": {\"minimum\": 0, \"type\": \"integer\"}, \"type\": \"array\", \"maxItems\": 3}, \"type\": {\"enum\": [\"Ewald\"], \"type\": \"string\"}, \"rcut\": {\"minItems\": 1, \"items\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": \"array\"}}}";
-	std::string SAPHRON::JsonSchema::DSFFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"alpha\", \"rcut\"], \"type\": \"object\", \"properties\": {\"alpha\": {\"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"DSF\"], \"type\": \"string\"}, \"rcut\": {\"minItems\": 1, \"items\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": \"array\"}}}";
-	std::string SAPHRON::JsonSchema::DebyeHuckelFF = "{\"additionalProperties\": false, \"required\": [\"type\", \"kappa\", \"rcut\"], \"type\": \"object\", \"properties\": {\"kappa\": {\"minimum\": 0, \"type\": \"number\"}, \"type\": {\"enum\": [\"DebyeHuckel\"], \"type\": \"string\"}, \"rcut\": {\"minItems\": 1, \"items\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"type\": \"array\"}}}";
-	std::string SAPHRON::JsonSchema::Worlds = "{\"minItems\": 1, \"type\": \"array\", \"items\": {\"additionalProperties\": false, \"varname\": \"SimpleWorld\", \"required\": [\"type\", \"dimensions\", \"nlist_cutoff\", \"skin_thickness\", \"components\"], \"type\": \"object\", \"properties\": {\"dimensions\": {\"additionalItems\": false, \"minItems\": 3, \"varname\": \"Position\", \"maxItems\": 3, \"items\": {\"type\": \"number\"}, \"type\": \"array\"}, \"periodic\": {\"additionalProperties\": false, \"type\": \"object\", \"properties\": {\"y\": {\"type\": \"boolean\"}, \"x\": {\"type\": \"boolean\"}, \"z\": {\"type\": \"boolean\"}}}, \"components\": {\"minItems\": 1, \"varname\": \"Components\", \"type\": \"array\", \"items\": {\"minItems\": 2, \"items\": [{\"type\": \"string\"}, {\"minimum\": 1, \"type\": \"integer\"}], \"type\": \"array\", \"maxItems\": 2}}, \"skin_thickness\": {\"minimum\": 0, \"type\": \"number\"}, \"particles\": {\"type\": \"array\"}, \"lattice\": {\"type\": \"object\", \"properties\": {\"composition\": {\"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"exclusiveMinimum\": true, \"minimum\": 0.0, \"type\": \"number\", \"maximum\": 1.0}}, \"type\": \"object\"}}}, \"seed\": {\"minimum\": 0, \"type\": \"integer\"}, \"chemical_potential\": {\"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"type\": \"number\"}}, \"type\": \"object\"}, \"nlist_cutoff\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"pack\": {\"type\": \"object\", \"properties\": {\"count\": {\"minimum\": 1, \"type\": \"integer\"}, \"composition\": {\"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"exclusiveMinimum\": true, \"minimum\": 0.0, \"type\": \"number\", \"maximum\": 1.0}}, \"type\": \"object\"}, \"density\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}}}, \"type\": {\"enum\": [\"Simple\"], \"type\": \"string\"}, \"temperature\": {\"minimum\": 0, \"type\": \"number\"}}}}";
-	std::string SAPHRON::JsonSchema::SimpleWorld = "{\"additionalProperties\": false, \"required\": [\"type\", \"dimensions\", \"nlist_cutoff\", \"skin_thickness\", \"components\"], \"type\": \"object\", \"properties\": {\"dimensions\": {\"additionalItems\": false, \"minItems\": 3, \"varname\": \"Position\", \"maxItems\": 3, \"items\": {\"type\": \"number\"}, \"type\": \"array\"}, \"periodic\": {\"additionalProperties\": false, \"type\": \"object\", \"properties\": {\"y\": {\"type\": \"boolean\"}, \"x\": {\"type\": \"boolean\"}, \"z\": {\"type\": \"boolean\"}}}, \"components\": {\"minItems\": 1, \"varname\": \"Components\", \"type\": \"array\", \"items\": {\"minItems\": 2, \"items\": [{\"type\": \"string\"}, {\"minimum\": 1, \"type\": \"integer\"}], \"type\": \"array\", \"maxItems\": 2}}, \"skin_thickness\": {\"minimum\": 0, \"type\": \"number\"}, \"particles\": {\"type\": \"array\"}, \"lattice\": {\"type\": \"object\", \"properties\": {\"composition\": {\"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"exclusiveMinimum\": true, \"minimum\": 0.0, \"type\": \"number\", \"maximum\": 1.0}}, \"type\": \"object\"}}}, \"seed\": {\"minimum\": 0, \"type\": \"integer\"}, \"chemical_potential\": {\"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"type\": \"number\"}}, \"type\": \"object\"}, \"nlist_cutoff\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}, \"pack\": {\"type\": \"object\", \"properties\": {\"count\": {\"minimum\": 1, \"type\": \"integer\"}, \"composition\": {\"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"exclusiveMinimum\": true, \"minimum\": 0.0, \"type\": \"number\", \"maximum\": 1.0}}, \"type\": \"object\"}, \"density\": {\"exclusiveMinimum\": true, \"minimum\": 0, \"type\": \"number\"}}}, \"type\": {\"enum\": [\"Simple\"], \"type\": \"string\"}, \"temperature\": {\"minimum\": 0, \"type\": \"number\"}}}";
+	std::string SAPHRON::JsonSchema::ForceFields = "{\"type\": \"object\", \"properties\": {\"nonbonded\": {\"type\": \"array\"}, \"bonded\": {\"type\": \"array\"}, \"electrostatic\": {\"type\": \"object\"}, \"constraints\": {\"type\": \"array\"}, \"energy_cache\": {\"type\": \"boolean\"}, \"intra_scaling\": {\"type\": \"array\", \"items\": {\"type\": \"number\", \"minimum\": 0}, \"minItems\": 3, \"maxItems\": 3}}, \"additionalProperties\": false}";
+	std::string SAPHRON::JsonSchema::FENEFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"FENE\"]}, \"epsilon\": {\"type\": \"number\"}, \"sigma\": {\"type\": \"number\", \"minimum\": 0}, \"kspring\": {\"type\": \"number\", \"minimum\": 0}, \"rmax\": {\"type\": \"number\", \"minimum\": 0}, \"species\": {\"type\": \"array\", \"minItems\": 2, \"maxItems\": 2, \"items\": {\"type\": \"string\"}, \"additionalItems\": false}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\", \"epsilon\", \"sigma\", \"kspring\", \"rmax\", \"species\"]}";
+	std::string SAPHRON::JsonSchema::EwaldFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"Ewald\"]}, \"alpha\": {\"type\": \"number\", \"minimum\": 0}, \"kmax\": {\"type\": \"array\", \"items\": {\"type\": \"integer\", \"minimum\": 0}, \"minItems\": 3, \"maxItems\": 3}, \"tolerance\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rcut\": {\"type\": \"array\", \"items\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"minItems\": 1}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\"]}";
+	std::string SAPHRON::JsonSchema::DSFFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"DSF\"]}, \"alpha\": {\"type\": \"number\", \"minimum\": 0}, \"rcut\": {\"type\": \"array\", \"items\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"minItems\": 1}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\", \"alpha\", \"rcut\"]}";
+	std::string SAPHRON::JsonSchema::DebyeHuckelFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"DebyeHuckel\"]}, \"kappa\": {\"type\": \"number\", \"minimum\": 0}, \"rcut\": {\"type\": \"array\", \"items\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"minItems\": 1}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\", \"kappa\", \"rcut\"]}";
+	std::string SAPHRON::JsonSchema::Worlds = "{\"type\": \"array\", \"items\": {\"type\": \"object\", \"varname\": \"SimpleWorld\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"Simple\"]}, \"dimensions\": {\"type\": \"array\", \"varname\": \"Position\", \"minItems\": 3, \"maxItems\": 3, \"items\": {\"type\": \"number\"}, \"additionalItems\": false}, \"seed\": {\"type\": \"integer\", \"minimum\": 0}, \"nlist_cutoff\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"nlist_method\": {\"type\": \"string\", \"enum\": [\"allpairs\", \"cell\"]}, \"sort_frequency\": {\"type\": \"integer\", \"minimum\": 0}, \"skin_thickness\": {\"type\": \"number\", \"minimum\": 0}, \"skin_tune\": {\"type\": \"object\", \"properties\": {\"window\": {\"type\": \"integer\", \"minimum\": 1}}, \"additionalProperties\": false}, \"particles\": {\"type\": \"array\"}, \"components\": {\"type\": \"array\", \"varname\": \"Components\", \"items\": {\"type\": \"array\", \"items\": [{\"type\": \"string\"}, {\"type\": \"integer\", \"minimum\": 1}], \"minItems\": 2, \"maxItems\": 2}, \"minItems\": 1}, \"temperature\": {\"type\": \"number\", \"minimum\": 0}, \"periodic\": {\"type\": \"object\", \"properties\": {\"x\": {\"type\": \"boolean\"}, \"y\": {\"type\": \"boolean\"}, \"z\": {\"type\": \"boolean\"}}, \"additionalProperties\": false}, \"pack\": {\"type\": \"object\", \"properties\": {\"count\": {\"type\": \"integer\", \"minimum\": 1}, \"density\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"composition\": {\"type\": \"object\", \"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"type\": \"number\", \"minimum\": 0.0, \"maximum\": 1.0, \"exclusiveMinimum\": true}}}}}, \"lattice\": {\"type\": \"object\", \"properties\": {\"composition\": {\"type\": \"object\", \"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"type\": \"number\", \"minimum\": 0.0, \"maximum\": 1.0, \"exclusiveMinimum\": true}}}}}, \"chemical_potential\": {\"type\": \"object\", \"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"type\": \"number\"}}}}, \"required\": [\"type\", \"dimensions\", \"nlist_cutoff\", \"skin_thickness\", \"components\"], \"additionalProperties\": false}, \"minItems\": 1}";
+	std::string SAPHRON::JsonSchema::SimpleWorld = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"Simple\"]}, \"dimensions\": {\"type\": \"array\", \"varname\": \"Position\", \"minItems\": 3, \"maxItems\": 3, \"items\": {\"type\": \"number\"}, \"additionalItems\": false}, \"seed\": {\"type\": \"integer\", \"minimum\": 0}, \"nlist_cutoff\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"nlist_method\": {\"type\": \"string\", \"enum\": [\"allpairs\", \"cell\"]}, \"sort_frequency\": {\"type\": \"integer\", \"minimum\": 0}, \"skin_thickness\": {\"type\": \"number\", \"minimum\": 0}, \"skin_tune\": {\"type\": \"object\", \"properties\": {\"window\": {\"type\": \"integer\", \"minimum\": 1}}, \"additionalProperties\": false}, \"particles\": {\"type\": \"array\"}, \"components\": {\"type\": \"array\", \"varname\": \"Components\", \"items\": {\"type\": \"array\", \"items\": [{\"type\": \"string\"}, {\"type\": \"integer\", \"minimum\": 1}], \"minItems\": 2, \"maxItems\": 2}, \"minItems\": 1}, \"temperature\": {\"type\": \"number\", \"minimum\": 0}, \"periodic\": {\"type\": \"object\", \"properties\": {\"x\": {\"type\": \"boolean\"}, \"y\": {\"type\": \"boolean\"}, \"z\": {\"type\": \"boolean\"}}, \"additionalProperties\": false}, \"pack\": {\"type\": \"object\", \"properties\": {\"count\": {\"type\": \"integer\", \"minimum\": 1}, \"density\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"composition\": {\"type\": \"object\", \"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"type\": \"number\", \"minimum\": 0.0, \"maximum\": 1.0, \"exclusiveMinimum\": true}}}}}, \"lattice\": {\"type\": \"object\", \"properties\": {\"composition\": {\"type\": \"object\", \"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"type\": \"number\", \"minimum\": 0.0, \"maximum\": 1.0, \"exclusiveMinimum\": true}}}}}, \"chemical_potential\": {\"type\": \"object\", \"patternProperties\": {\"^[A-z][A-z0-9]+$\": {\"type\": \"number\"}}}}, \"required\": [\"type\", \"dimensions\", \"nlist_cutoff\", \"skin_thickness\", \"components\"], \"additionalProperties\": false}";
 	std::string SAPHRON::JsonSchema::Components = "{\"minItems\": 1, \"type\": \"array\", \"items\": {\"minItems\": 2, \"items\": [{\"type\": \"string\"}, {\"minimum\": 1, \"type\": \"integer\"}], \"type\": \"array\", \"maxItems\": 2}}";
 	std::string SAPHRON::JsonSchema::Site = "{\"additionalItems\": false, \"minItems\": 3, \"maxItems\": 5, \"items\": [{\"minimum\": 1, \"type\": \"integer\"}, {\"type\": \"string\"}, {\"additionalItems\": false, \"minItems\": 3, \"varname\": \"Position\", \"maxItems\": 3, \"items\": {\"type\": \"number\"}, \"type\": \"array\"}, {\"additionalItems\": false, \"minItems\": 3, \"varname\": \"Director\", \"maxItems\": 3, \"items\": {\"type\": \"number\"}, \"type\": \"array\"}, {\"type\": \"string\"}], \"type\": \"array\"}";
 	std::string SAPHRON::JsonSchema::Selector = "{}";
@@ -41,7 +41,7 @@ namespace SAPHRON
 	std::string SAPHRON::JsonSchema::XYZObserver = "{\"additionalProperties\": false, \"required\": [\"type\", \"prefix\", \"frequency\"], \"type\": \"object\", \"properties\": {\"prefix\": {\"type\": \"string\"}, \"frequency\": {\"minimum\": 1, \"type\": \"integer\"}, \"type\": {\"enum\": [\"XYZ\"], \"type\": \"string\"}}}";
 	std::string SAPHRON::JsonSchema::Observers = "{\"type\": \"array\"}";
 	std::string SAPHRON::JsonSchema::JSONObserver = "{\"additionalProperties\": false, \"required\": [\"type\", \"prefix\", \"frequency\"], \"type\": \"object\", \"properties\": {\"prefix\": {\"type\": \"string\"}, \"frequency\": {\"minimum\": 1, \"type\": \"integer\"}, \"type\": {\"enum\": [\"JSON\"], \"type\": \"string\"}}}";
-	std::string SAPHRON::JsonSchema::DLMFileObserver = "{\"additionalProperties\": false, \"required\": [\"type\", \"prefix\", \"frequency\", \"flags\"], \"type\": \"object\", \"properties\": {\"extension\": {\"type\": \"string\"}, \"fixedwmode\": {\"type\": \"boolean\"}, \"prefix\": {\"type\": \"string\"}, \"delimiter\": {\"type\": \"string\"}, \"frequency\": {\"minimum\": 1, \"type\": \"integer\"}, \"flags\": {\"type\": \"object\", \"properties\": {\"energy_connectivity\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"hist_bin_count\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"energy_interelect\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"energy_intravdw\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle_species_id\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle_parent_species\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"energy_components\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_pxx\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_pxy\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"world_chem_pot\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"energy_constraint\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"hist_upper_outliers\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"energy_bonded\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_tensor\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle_charge\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_pzz\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle_id\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"hist_values\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle_parent_id\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"hist_interval\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"world_energy\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"hist_counts\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"move_acceptances\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"world_pressure\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"energy_intraelect\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"dos_op\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"world_volume\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"hist_lower_outliers\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle_species\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"world_density\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"dos_flatness\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_pxz\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"dos_factor\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"energy_intervdw\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"energy_tail\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"world\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"histogram\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"world_temperature\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_pyz\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_pyy\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_tail\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"iteration\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"simulation\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle_director\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"particle_position\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"world_composition\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}, \"pressure_ideal\": {\"minimum\": 0, \"type\": \"integer\", \"maximum\": 1}}}, \"colwidth\": {\"minimum\": 1, \"type\": \"integer\"}, \"type\": {\"enum\": [\"DLMFile\"], \"type\": \"string\"}}}";
+	std::string SAPHRON::JsonSchema::DLMFileObserver = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"DLMFile\"]}, \"prefix\": {\"type\": \"string\"}, \"colwidth\": {\"type\": \"integer\", \"minimum\": 1}, \"fixedwmode\": {\"type\": \"boolean\"}, \"delimiter\": {\"type\": \"string\"}, \"frequency\": {\"type\": \"integer\", \"minimum\": 1}, \"extension\": {\"type\": \"string\"}, \"flags\": {\"type\": \"object\", \"properties\": {\"simulation\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_components\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_tensor\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"histogram\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"iteration\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"move_acceptances\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"dos_factor\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"dos_flatness\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"dos_op\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world_pressure\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world_volume\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world_density\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world_temperature\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world_composition\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world_energy\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world_chem_pot\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"world_skin\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_intervdw\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_intravdw\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_interelect\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_intraelect\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_bonded\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_connectivity\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_constraint\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"energy_tail\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_ideal\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_pxx\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_pxy\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_pxz\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_pyy\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_pyz\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_pzz\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"pressure_tail\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"hist_interval\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"hist_bin_count\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"hist_lower_outliers\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"hist_upper_outliers\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"hist_values\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"hist_counts\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle_id\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle_species\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle_species_id\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle_parent_id\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle_parent_species\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle_charge\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle_position\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}, \"particle_director\": {\"type\": \"integer\", \"minimum\": 0, \"maximum\": 1}}}}, \"required\": [\"type\", \"prefix\", \"frequency\", \"flags\"], \"additionalProperties\": false}";
 	std::string SAPHRON::JsonSchema::WidomInsertionMove = "{\"additionalProperties\": false, \"required\": [\"type\", \"species\"], \"type\": \"object\", \"properties\": {\"seed\": {\"minimum\": 0, \"type\": \"integer\"}, \"type\": {\"enum\": [\"WidomInsertion\"], \"type\": \"string\"}, \"species\": {\"items\": {\"type\": \"string\"}, \"type\": \"array\", \"minimumItems\": 1}, \"weight\": {\"minimum\": 1, \"type\": \"integer\"}}}";
 	std::string SAPHRON::JsonSchema::VolumeSwapMove = "{\"additionalProperties\": false, \"required\": [\"type\", \"dv\"], \"type\": \"object\", \"properties\": {\"dv\": {\"minimum\": 0, \"type\": \"number\"}, \"seed\": {\"minimum\": 0, \"type\": \"integer\"}, \"type\": {\"enum\": [\"VolumeSwap\"], \"type\": \"string\"}, \"weight\": {\"minimum\": 1, \"type\": \"integer\"}}}";
 	std::string SAPHRON::JsonSchema::VolumeScaleMove = "{\"additionalProperties\": false, \"required\": [\"type\", \"dv\", \"Pextern\"], \"type\": \"object\", \"properties\": {\"dv\": {\"minimum\": 0, \"type\": \"number\"}, \"Pextern\": {\"minimum\": 0, \"type\": \"number\"}, \"seed\": {\"minimum\": 0, \"type\": \"integer\"}, \"type\": {\"enum\": [\"VolumeScale\"], \"type\": \"string\"}, \"weight\": {\"minimum\": 1, \"type\": \"integer\"}}}";
@@ -59,5 +59,6 @@ namespace SAPHRON
 	std::string SAPHRON::JsonSchema::AnnealChargeMove = "{\"additionalProperties\": false, \"required\": [\"type\", \"species\"], \"type\": \"object\", \"properties\": {\"explicit_draw\": {\"type\": \"boolean\"}, \"seed\": {\"minimum\": 0, \"type\": \"integer\"}, \"type\": {\"enum\": [\"AnnealCharge\"], \"type\": \"string\"}, \"species\": {\"minItems\": 1, \"items\": {\"type\": \"string\"}, \"type\": \"array\"}, \"weight\": {\"minimum\": 1, \"type\": \"integer\"}}}";
 	std::string SAPHRON::JsonSchema::AcidTitrationMove = "{\"additionalProperties\": false, \"required\": [\"type\", \"species\", \"mu\"], \"type\": \"object\", \"properties\": {\"weight\": {\"minimum\": 1, \"type\": \"integer\"}, \"mu\": {\"type\": \"number\"}, \"op_prefactor\": {\"type\": \"boolean\"}, \"seed\": {\"minimum\": 0, \"type\": \"integer\"}, \"proton_charge\": {\"type\": \"number\"}, \"type\": {\"enum\": [\"AcidTitrate\"], \"type\": \"string\"}, \"species\": {\"minItems\": 1, \"items\": {\"type\": \"string\"}, \"type\": \"array\"}}}";
 	std::string SAPHRON::JsonSchema::AcidReactionMove = "{\"additionalProperties\": false, \"required\": [\"type\", \"products\", \"swap\", \"pKo\", \"stash_count\"], \"type\": \"object\", \"properties\": {\"reactants\": {\"minItems\": 1, \"items\": {\"type\": \"string\"}, \"type\": \"array\"}, \"weight\": {\"minimum\": 1, \"type\": \"integer\"}, \"stash_count\": {\"minimum\": 1, \"type\": \"integer\"}, \"op_prefactor\": {\"type\": \"boolean\"}, \"seed\": {\"minimum\": 0, \"type\": \"integer\"}, \"products\": {\"minItems\": 1, \"items\": {\"type\": \"string\"}, \"type\": \"array\"}, \"swap\": {\"minItems\": 1, \"items\": {\"type\": \"string\"}, \"type\": \"array\"}, \"type\": {\"enum\": [\"AcidReaction\"], \"type\": \"string\"}, \"pKo\": {\"type\": \"number\"}}}";
+	std::string SAPHRON::JsonSchema::SPMEFF = "{\"type\": \"object\", \"properties\": {\"type\": {\"type\": \"string\", \"enum\": [\"SPME\"]}, \"alpha\": {\"type\": \"number\", \"minimum\": 0}, \"grid\": {\"type\": \"array\", \"items\": {\"type\": \"integer\", \"minimum\": 2}, \"minItems\": 3, \"maxItems\": 3}, \"order\": {\"type\": \"integer\", \"minimum\": 2, \"maximum\": 16}, \"slab_factor\": {\"type\": \"number\", \"minimum\": 1}, \"rcut\": {\"type\": \"array\", \"items\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"minItems\": 1}, \"tabulate\": {\"type\": \"object\", \"properties\": {\"points\": {\"type\": \"integer\", \"minimum\": 2}, \"rmin\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}, \"rmax\": {\"type\": \"number\", \"minimum\": 0, \"exclusiveMinimum\": true}}, \"additionalProperties\": false, \"required\": [\"points\"]}}, \"additionalProperties\": false, \"required\": [\"type\", \"alpha\", \"rcut\", \"grid\"]}";
 	
 }
\ No newline at end of file
@@ -26,22 +26,24 @@ namespace SAPHRON
 		DirectorRotateMove (unsigned seed = 3) 
 		: _rand(seed), _rejected(0), _performed(0), _seed(seed) {}
 
-		// Director rotation. Used for unit testing. 
-		void Perform(Particle* particle)
+		// Draws a random unit vector.
+		Director RandomDirector()
 		{
-			// Get new unit vector.
-			double v3 = 0;
+			double v1 = 0, v2 = 0, v3 = 0;
 			do
 			{
-				double v1 = _rand.doub();
-				double v2 = _rand.doub();
-				v1 = 1 - 2 * v1;
-				v2 = 1 - 2 * v2;
+				v1 = 1 - 2 * _rand.doub();
+				v2 = 1 - 2 * _rand.doub();
 				v3 = v1*v1 + v2*v2;
-				if(v3 < 1)
-					particle->SetDirector(2.0*v1*sqrt(1 - v3), 2.0*v2*sqrt(1 - v3), 1.0-2.0*v3);
-			} while(v3 > 1);
+			} while(v3 >= 1);
 
+			return Director({2.0*v1*sqrt(1 - v3), 2.0*v2*sqrt(1 - v3), 1.0-2.0*v3});
+		}
+
+		// Director rotation. Used for unit testing. 
+		void Perform(Particle* particle)
+		{
+			particle->SetDirector(RandomDirector());
 			++_performed;
 		}
 
@@ -52,18 +54,30 @@ namespace SAPHRON
 			World* w = wm->GetRandomWorld();
 			Particle* particle = w->DrawRandomParticle();
 
-			// Get initial director, energy.
+			// Get initial director.
 			Director di = particle->GetDirector();
-			auto ei = ffm->EvaluateEnergy(*particle);
-			ei.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
+			Director df = RandomDirector();
+			++_performed;
 
-			// Perform director rotation.
-			Perform(particle);
+			// Single atoms without constraints or intramolecular terms 
+			// are only rotated if accepted. Otherwise the particle is 
+			// rotated to evaluate the final energy.
+			Energy de;
+			bool moved = ffm->HasConstraints(*w) || particle->HasChildren() || particle->HasParent() || 
+			             particle->GetBondedNeighbors().size() || particle->GetConnectivities().size();
+			if(!moved)
+				de = ffm->EvaluateDeltaEnergy(*particle, particle->GetPosition(), df).energy;
+			else
+			{
+				auto ei = ffm->EvaluateEnergyOnly(*particle);
+				ei.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
 
-			// Evaluate final energy and check probability.
-			auto ef = ffm->EvaluateEnergy(*particle);
-			ef.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
-			Energy de = ef.energy - ei.energy;
+				particle->SetDirector(df);
+
+				auto ef = ffm->EvaluateEnergyOnly(*particle);
+				ef.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
+				de = ef.energy - ei.energy;
+			}
 				
 			// Get sim info for kB.
 			auto sim = SimInfo::Instance();
@@ -75,14 +89,18 @@ namespace SAPHRON
 			// Reject or accept move.
 			if(!(override == ForceAccept) && (p < _rand.doub() || override == ForceReject))
 			{
-				particle->SetDirector(di);
+				if(moved)
+					particle->SetDirector(di);
 				++_rejected;
 			}
 			else
 			{
+				if(!moved)
+					particle->SetDirector(df);
+
 				// Update energies and pressures.
 				w->IncrementEnergy(de);
-				w->IncrementPressure(ef.pressure - ei.pressure);
+				w->InvalidatePressure();
 			}	
 
 		}
@@ -93,19 +111,19 @@ namespace SAPHRON
 			Particle* particle = world->DrawRandomParticle();
 
 			Director di = particle->GetDirector();
-			auto ei = ffm->EvaluateEnergy(*particle);
+			auto ei = ffm->EvaluateEnergyOnly(*particle);
 			auto opi = op->EvaluateOrderParameter(*world);
 			
 			// Perform
 			Perform(particle);
 
 			// Evaluate final energy and order parameter and check probability. 
-			auto ef = ffm->EvaluateEnergy(*particle);
+			auto ef = ffm->EvaluateEnergyOnly(*particle);
 			Energy de = ef.energy - ei.energy;
 
 			// Update energies and pressures.
 			world->IncrementEnergy(de);
-			world->IncrementPressure(ef.pressure - ei.pressure);
+			world->InvalidatePressure();
 
 			auto opf = op->EvaluateOrderParameter(*world);
 
@@ -117,9 +135,8 @@ namespace SAPHRON
 			{
 				particle->SetDirector(di);
 
-				// Update energies and pressures.
+				// Update energies.
 				world->IncrementEnergy(-1.0*de);
-				world->IncrementPressure(ei.pressure - ef.pressure);
 				
 				++_rejected;
 			}
@@ -46,11 +46,11 @@ namespace SAPHRON
 			
 			// Get initial director and evaluate energy.
 			auto di = particle->GetDirector();
-			auto ei = ffm->EvaluateEnergy(*particle);
+			auto ei = ffm->EvaluateEnergyOnly(*particle);
 
 			// Perform move and evaluate new energy.
 			Perform(particle, di);
-			auto ef = ffm->EvaluateEnergy(*particle);
+			auto ef = ffm->EvaluateEnergyOnly(*particle);
 			Energy de = ef.energy - ei.energy;
 
 			// Get sim info for kB.
@@ -70,7 +70,7 @@ namespace SAPHRON
 			{
 				// Update energies and pressures.
 				w->IncrementEnergy(de);
-				w->IncrementPressure(ef.pressure - ei.pressure);
+				w->InvalidatePressure();
 			}	
 		}
 
@@ -81,17 +81,17 @@ namespace SAPHRON
 			
 			// Get initial director and evaluate energy and order parameter.
 			auto di = particle->GetDirector();
-			auto ei = ffm->EvaluateEnergy(*particle);
+			auto ei = ffm->EvaluateEnergyOnly(*particle);
 			auto opi = op->EvaluateOrderParameter(*w);
 
 			// Perform move and evaluate new energy and order parameter.
 			Perform(particle, di);
-			auto ef = ffm->EvaluateEnergy(*particle);
+			auto ef = ffm->EvaluateEnergyOnly(*particle);
 			Energy de = ef.energy - ei.energy;
 
 			// Update energies and pressures.
 			w->IncrementEnergy(de);
-			w->IncrementPressure(ef.pressure - ei.pressure);
+			w->InvalidatePressure();
 
 			auto opf = op->EvaluateOrderParameter(*w);
 
@@ -103,9 +103,8 @@ namespace SAPHRON
 			{
 				particle->SetDirector(di);
 				
-				// Update energies and pressures.
+				// Update energies.
 				w->IncrementEnergy(-1.0*de);
-				w->IncrementPressure(ei.pressure - ef.pressure);
 
 				++_rejected;
 			}
@@ -63,27 +63,36 @@ namespace SAPHRON
 			World* w = wm->GetRandomWorld();
 			Particle* particle = w->DrawRandomParticle();
 
-			// Evaluate initial particle energy. 
-			auto ei = ffm->EvaluateInterEnergy(*particle);
-			ei.energy.constraint = w->GetEnergy().constraint;
-
 			// Choose random axis, and generate random angle.
 			int axis = _rand.int32() % 3 + 1;
 			double deg = (2.0*_rand.doub() - 1.0)*_maxangle;
 			Matrix3D R = GenRotationMatrix(axis, deg);
-
-			// Rotate particle.
-			Rotate(particle, R);
 			++_performed;
 
-			// Update neighbor list if needed.
-			w->CheckNeighborListUpdate(particle->GetChildren());
+			// Rotating a single atom only changes its director. Without 
+			// constraints it is only rotated if accepted. Otherwise the 
+			// particle is rotated to evaluate the final energy.
+			Energy de;
+			bool moved = ffm->HasConstraints(*w) || particle->HasChildren() || particle->HasParent();
+			if(!moved)
+				de = ffm->EvaluateDeltaEnergy(*particle, particle->GetPosition(), R*particle->GetDirector()).energy;
+			else
+			{
+				// Evaluate initial particle energy. 
+				auto ei = ffm->EvaluateInterEnergyOnly(*particle);
+				ei.energy.constraint = w->GetEnergy().constraint;
 
-			// Evaluate final particle energy and get delta E. 
-			auto ef = ffm->EvaluateInterEnergy(*particle);
-			ef.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
+				// Rotate particle.
+				Rotate(particle, R);
 
-			Energy de = ef.energy - ei.energy;
+				// Update neighbor list if needed.
+				w->CheckNeighborListUpdate(particle->GetChildren());
+
+				// Evaluate final particle energy and get delta E. 
+				auto ef = ffm->EvaluateInterEnergyOnly(*particle);
+				ef.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
+				de = ef.energy - ei.energy;
+			}
 
 			// Get sim info for kB.
 			auto sim = SimInfo::Instance();
@@ -95,19 +104,24 @@ namespace SAPHRON
 			// Reject or accept move.
 			if(!(override == ForceAccept) && (p < _rand.doub() || override == ForceReject))
 			{
-				// Rotate back. 
-				Rotate(particle, R.t());
-	
-				// Update neighbor list if needed.
-				w->CheckNeighborListUpdate(particle->GetChildren());
-
+				if(moved)
+				{
+					// Rotate back. 
+					Rotate(particle, R.t());
+		
+					// Update neighbor list if needed.
+					w->CheckNeighborListUpdate(particle->GetChildren());
+				}
 				++_rejected;
 			}
 			else
 			{
+				if(!moved)
+					Rotate(particle, R);
+
 				// Update energies and pressures.
 				w->IncrementEnergy(de);
-				w->IncrementPressure(ef.pressure - ei.pressure);
+				w->InvalidatePressure();
 			}
 		}
 
@@ -120,7 +134,7 @@ namespace SAPHRON
 			Particle* particle = w->DrawRandomParticle();
 
 			// Evaluate initial particle energy. 
-			auto ei = ffm->EvaluateInterEnergy(*particle);
+			auto ei = ffm->EvaluateInterEnergyOnly(*particle);
 			ei.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
 			auto opi = op->EvaluateOrderParameter(*w);
 
@@ -137,13 +151,13 @@ namespace SAPHRON
 			w->CheckNeighborListUpdate(particle->GetChildren());
 
 			// Evaluate final particle energy and get delta E. 
-			auto ef = ffm->EvaluateInterEnergy(*particle);
+			auto ef = ffm->EvaluateInterEnergyOnly(*particle);
 			ef.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
 			Energy de = ef.energy - ei.energy;
 
 			// Update energies and pressures.
 			w->IncrementEnergy(de);
-			w->IncrementPressure(ef.pressure - ei.pressure);
+			w->InvalidatePressure();
 
 			auto opf = op->EvaluateOrderParameter(*w);
 			
@@ -155,9 +169,8 @@ namespace SAPHRON
 			{
 				Rotate(particle, R.t());
 				
-				// Update energies and pressures.
+				// Update energies.
 				w->IncrementEnergy(-1.0*de);
-				w->IncrementPressure(ei.pressure - ef.pressure);
 		
 				// Update neighbor list if needed.
 				w->CheckNeighborListUpdate(particle->GetChildren());
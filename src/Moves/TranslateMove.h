@@ -126,10 +126,6 @@ namespace SAPHRON
 
 			// Initial position.
 			auto posi = particle->GetPosition();
-			
-			// Evaluate initial particle energy. 
-			auto ei = ffm->EvaluateInterEnergy(*particle);
-			ei.energy.constraint = w->GetEnergy().constraint;
 
 			// Generate new position then apply periodic boundaries.
 			Position newPos({posi[0] + dx*(_rand.doub()-0.5), 
@@ -137,16 +133,31 @@ namespace SAPHRON
 							 posi[2] + dx*(_rand.doub()-0.5)});
 			
 			w->ApplyPeriodicBoundaries(&newPos);
-			particle->SetPosition(newPos);
-			++_performed;		
+			++_performed;
 
-			// Update neighbor list if needed.
-			w->CheckNeighborListUpdate(particle);						
+			// If neighbor lists hold at the new position and there are no 
+			// constraints, the particle is only moved if accepted. 
+			// Otherwise it is moved to evaluate the final energy.
+			Energy de;
+			bool moved = ffm->HasConstraints(*w) || !w->IsNeighborListValid(particle, newPos - posi);
+			if(!moved)
+				de = ffm->EvaluateDeltaEnergy(*particle, newPos).energy;
+			else
+			{
+				// Evaluate initial particle energy. 
+				auto ei = ffm->EvaluateInterEnergyOnly(*particle);
+				ei.energy.constraint = w->GetEnergy().constraint;
 
-			// Evaluate final particle energy and get delta E. 
-			auto ef = ffm->EvaluateInterEnergy(*particle);
-			ef.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
-			Energy de = ef.energy - ei.energy;
+				particle->SetPosition(newPos);
+
+				// Update neighbor list if needed.
+				w->CheckNeighborListUpdate(particle);
+
+				// Evaluate final particle energy and get delta E. 
+				auto ef = ffm->EvaluateInterEnergyOnly(*particle);
+				ef.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
+				de = ef.energy - ei.energy;
+			}
 			
 			// Get sim info for kB.
 			auto& sim = SimInfo::Instance();
@@ -158,17 +169,26 @@ namespace SAPHRON
 			// Reject or accept move.
 			if(!(override == ForceAccept) && (p < _rand.doub() || override == ForceReject))
 			{
-				particle->SetPosition(posi);
+				if(moved)
+				{
+					particle->SetPosition(posi);
 
-				// Update neighbor list if needed.
-				w->CheckNeighborListUpdate(particle);
+					// Update neighbor list if needed.
+					w->CheckNeighborListUpdate(particle);
+				}
 				++_rejected;
 			}
 			else
 			{
+				if(!moved)
+				{
+					particle->SetPosition(newPos);
+					w->CheckNeighborListUpdate(particle);
+				}
+
 				// Update energies and pressures.
 				w->IncrementEnergy(de);
-				w->IncrementPressure(ef.pressure - ei.pressure);
+				w->InvalidatePressure();
 			}	
 		}
 		
@@ -204,7 +224,7 @@ namespace SAPHRON
 			auto posi = particle->GetPosition();
 			
 			// Evaluate initial particle energy. 
-			auto ei = ffm->EvaluateInterEnergy(*particle);
+			auto ei = ffm->EvaluateInterEnergyOnly(*particle);
 			ei.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
 			auto opi = op->EvaluateOrderParameter(*w);
 
@@ -221,13 +241,13 @@ namespace SAPHRON
 			w->CheckNeighborListUpdate(particle);
 
 			// Evaluate final particle energy and get delta E. 
-			auto ef = ffm->EvaluateInterEnergy(*particle);
+			auto ef = ffm->EvaluateInterEnergyOnly(*particle);
 			ef.energy.constraint = ffm->EvaluateConstraintEnergy(*w);
 			Energy de = ef.energy - ei.energy;
 			
 			// Update energies and pressures.
 			w->IncrementEnergy(de);
-			w->IncrementPressure(ef.pressure - ei.pressure);
+			w->InvalidatePressure();
 
 			auto opf = op->EvaluateOrderParameter(*w);
 
@@ -239,9 +259,8 @@ namespace SAPHRON
 			{
 				particle->SetPosition(posi);
 				
-				// Update energies and pressures.
+				// Update energies.
 				w->IncrementEnergy(-1.0*de);
-				w->IncrementPressure(ei.pressure - ef.pressure);
 
 				// Update neighbor list if needed.
 				w->CheckNeighborListUpdate(particle);
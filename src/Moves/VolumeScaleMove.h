@@ -72,7 +72,7 @@ namespace SAPHRON
 			// Accept or reject.
 			if(!(override == ForceAccept) && (p < _rand.doub() || override == ForceReject))
 			{
-				w->SetVolume(vi, true);
+				w->RestoreVolume(vi);
 				++_rejected;
 			}
 			else
@@ -91,6 +91,7 @@ namespace SAPHRON
 			auto vi = w->GetVolume();
 			auto ei = w->GetEnergy();
 			auto pi = w->GetPressure();
+			auto pvalid = w->IsPressureValid();
 			auto n = w->GetParticleCount();
 			auto opi = op->EvaluateOrderParameter(*w);
 
@@ -118,9 +119,11 @@ namespace SAPHRON
 			// Accept or reject.
 			if(!(override == ForceAccept) && (pacc < _rand.doub() || override == ForceReject))
 			{
-				w->SetVolume(vi, true);
+				w->RestoreVolume(vi);
 				w->SetEnergy(ei);
 				w->SetPressure(pi);
+				if(!pvalid)
+					w->InvalidatePressure();
 				++_rejected;
 			}
 		}
@@ -109,8 +109,8 @@ namespace SAPHRON
 			// Undo move if it doesn't meet probability.
 			if(!(override == ForceAccept) && (p < _rand.doub() || override == ForceReject))
 			{
-				w1->SetVolume(vi1, true);
-				w2->SetVolume(vi2, true);
+				w1->RestoreVolume(vi1);
+				w2->RestoreVolume(vi2);
 				++_rejected;
 			}
 			else
@@ -166,8 +166,8 @@ namespace SAPHRON
 	    }
 		if (this->Flags.particle_neighbors)
 	    {
-	    	auto& neighbors = p->GetNeighbors();
-	        for(auto& neighbor : neighbors)
+	    	auto neighbors = p->GetNeighbors();
+	        for(auto* neighbor : neighbors)
 	           	cout << setw(20/neighbors.size()) << neighbor->GetGlobalIdentifier() << " ";
 	   	}
 
@@ -130,6 +130,8 @@ namespace SAPHRON
 				WriteStream(*_worldfs.back(), "Volume");
 			if(this->Flags.world_density)
 				WriteStream(*_worldfs.back(), "Density");
+			if(this->Flags.world_skin)
+				WriteStream(*_worldfs.back(), "Skin");
 			if(this->Flags.world_energy)
 				WriteStream(*_worldfs.back(), "Energy");
 			if(this->Flags.eintervdw)
@@ -372,6 +374,8 @@ namespace SAPHRON
 				WriteStream(*fs, w->GetVolume());
 			if(this->Flags.world_density)
 				WriteStream(*fs, w->GetNumberDensity());
+			if(this->Flags.world_skin)
+				WriteStream(*fs, w->GetSkinThickness());
 			if(this->Flags.world_energy)
 				WriteStream(*fs, E.total());
 			if(this->Flags.eintervdw)
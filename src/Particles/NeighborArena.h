@@ -0,0 +1,399 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace SAPHRON
+{
+	class Particle;
+
+	// Lightweight view of a neighbor list. It either refers to 32-bit
+	// primitive indices in a world's neighbor arena, which are resolved
+	// through the world's primitive list, or to a plain array of
+	// particle pointers for particles that do not belong to a world.
+	class NeighborSpan
+	{
+	private:
+		const uint32_t* _indices;
+		Particle* const* _particles;
+		size_t _size;
+
+	public:
+		class const_iterator
+		{
+		private:
+			const uint32_t* _index;
+			Particle* const* _particle;
+
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef Particle* value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef Particle* const* pointer;
+			typedef Particle* reference;
+
+			const_iterator(const uint32_t* index, Particle* const* particle) :
+			_index(index), _particle(particle) {}
+
+			Particle* operator*() const
+			{
+				return (_index != nullptr) ? _particle[*_index] : *_particle;
+			}
+
+			const_iterator& operator++()
+			{
+				if(_index != nullptr)
+					++_index;
+				else
+					++_particle;
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				auto it = *this;
+				++(*this);
+				return it;
+			}
+
+			bool operator==(const const_iterator& rhs) const
+			{
+				return _index == rhs._index && _particle == rhs._particle;
+			}
+
+			bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+		};
+
+		typedef const_iterator iterator;
+
+		// Span over primitive indices resolved through primitives.
+		NeighborSpan(const uint32_t* indices, Particle* const* primitives, size_t size) :
+		_indices(indices), _particles(primitives), _size(size) {}
+
+		// Span over particle pointers.
+		NeighborSpan(Particle* const* particles, size_t size) :
+		_indices(nullptr), _particles(particles), _size(size) {}
+
+		// Get the number of neighbors.
+		size_t size() const { return _size; }
+
+		// Is the span empty?
+		bool empty() const { return _size == 0; }
+
+		// Get the kth neighbor.
+		Particle* operator[](size_t k) const
+		{
+			return (_indices != nullptr) ? _particles[_indices[k]] : _particles[k];
+		}
+
+		// Get primitive indices of neighbors. Returns nullptr if
+		// the span does not refer to a neighbor arena.
+		const uint32_t* indices() const { return _indices; }
+
+		const_iterator begin() const
+		{
+			return const_iterator(_indices, _particles);
+		}
+
+		const_iterator end() const
+		{
+			return (_indices != nullptr) ? const_iterator(_indices + _size, _particles) :
+			                               const_iterator(nullptr, _particles + _size);
+		}
+	};
+
+	// Compressed sparse row storage of the neighbor lists of a world's
+	// primitives. Each primitive owns a slot of 32-bit primitive indices
+	// described by an offset, count and capacity. Slots are laid out
+	// contiguously by Allocate on full rebuilds and single lists grow by
+	// relocating their slot to the end of the arena. Storage is reused
+	// between rebuilds so steady state updates do not allocate.
+	//
+	// Lists are symmetric. Each entry also stores the position of the 
+	// mirrored entry in the neighbor's slot, so pairs are unlinked by 
+	// swapping the last entry of both slots into place.
+	class NeighborArena
+	{
+	private:
+		// Neighbor indices and positions of the mirrored entries.
+		std::vector<uint32_t> _indices, _mirrors;
+
+		// Slot offsets, counts and capacities.
+		std::vector<uint32_t> _offsets, _counts, _capacities;
+
+		// Per slot cursor used by Pair.
+		std::vector<uint32_t> _cursors;
+
+		// Primitive list used to resolve indices.
+		const std::vector<Particle*>* _primitives;
+
+		// Total capacity of live slots.
+		size_t _used;
+
+		// Extra capacity given to slots on allocation.
+		static uint32_t Slack(uint32_t count) { return count/4 + 4; }
+
+		// Move slot i to the end of the arena with a new capacity.
+		void Relocate(size_t i, uint32_t capacity)
+		{
+			// Compact if most of the arena is abandoned slots.
+			if(_indices.size() > 2*_used + 1024)
+				Compact();
+
+			auto offset = (uint32_t)_indices.size();
+			_indices.resize(offset + capacity);
+			_mirrors.resize(offset + capacity);
+			std::copy(_indices.begin() + _offsets[i],
+			          _indices.begin() + _offsets[i] + _counts[i],
+			          _indices.begin() + offset);
+			std::copy(_mirrors.begin() + _offsets[i],
+			          _mirrors.begin() + _offsets[i] + _counts[i],
+			          _mirrors.begin() + offset);
+			_used += capacity - _capacities[i];
+			_offsets[i] = offset;
+			_capacities[i] = capacity;
+		}
+
+		// Remove abandoned space between slots.
+		void Compact()
+		{
+			std::vector<uint32_t> indices, mirrors;
+			indices.reserve(_used);
+			mirrors.reserve(_used);
+			for(size_t i = 0; i < _offsets.size(); ++i)
+			{
+				auto offset = (uint32_t)indices.size();
+				indices.insert(indices.end(), _indices.begin() + _offsets[i],
+				               _indices.begin() + _offsets[i] + _counts[i]);
+				mirrors.insert(mirrors.end(), _mirrors.begin() + _offsets[i],
+				               _mirrors.begin() + _offsets[i] + _counts[i]);
+				indices.resize(offset + _capacities[i]);
+				mirrors.resize(offset + _capacities[i]);
+				_offsets[i] = offset;
+			}
+			_indices.swap(indices);
+			_mirrors.swap(mirrors);
+		}
+
+		// Make room for one more neighbor of primitive i.
+		void Reserve(size_t i)
+		{
+			if(_counts[i] == _capacities[i])
+				Relocate(i, std::max(2*_capacities[i], (uint32_t)8));
+		}
+
+		// Remove entry k of primitive i by moving the last entry into 
+		// its place and pointing that entry's mirror at the new position.
+		void Erase(size_t i, uint32_t k)
+		{
+			auto last = _offsets[i] + --_counts[i];
+			auto pos = _offsets[i] + k;
+			if(pos == last)
+				return;
+
+			auto j = _indices[last];
+			auto m = _mirrors[last];
+			_indices[pos] = j;
+			_mirrors[pos] = m;
+			_mirrors[_offsets[j] + m] = k;
+		}
+
+	public:
+		NeighborArena(const std::vector<Particle*>* primitives) :
+		_indices(0), _mirrors(0), _offsets(0), _counts(0), _capacities(0),
+		_cursors(0), _primitives(primitives), _used(0) {}
+
+		// Get neighbors of primitive i.
+		NeighborSpan GetNeighbors(size_t i) const
+		{
+			return NeighborSpan(_indices.data() + _offsets[i],
+			                    _primitives->data(), _counts[i]);
+		}
+
+		// Get the number of neighbors of primitive i.
+		uint32_t GetCount(size_t i) const { return _counts[i]; }
+
+		// Get the total number of stored neighbor indices.
+		size_t GetSize() const { return _indices.size(); }
+
+		// Append an empty slot for a new primitive.
+		void Push()
+		{
+			_offsets.push_back((uint32_t)_indices.size());
+			_counts.push_back(0);
+			_capacities.push_back(0);
+		}
+
+		// Remove the last slot, which must be empty.
+		void Pop()
+		{
+			assert(_counts.back() == 0);
+			_used -= _capacities.back();
+			_offsets.pop_back();
+			_counts.pop_back();
+			_capacities.pop_back();
+		}
+
+		// Lay out all slots contiguously with room for at least
+		// counts[i] neighbors and mark them empty. Reuses storage.
+		void Allocate(const std::vector<uint32_t>& counts)
+		{
+			assert(counts.size() == _offsets.size());
+			uint32_t offset = 0;
+			for(size_t i = 0; i < counts.size(); ++i)
+			{
+				_offsets[i] = offset;
+				_counts[i] = 0;
+				_capacities[i] = counts[i] + Slack(counts[i]);
+				offset += _capacities[i];
+			}
+			_indices.resize(offset);
+			_mirrors.resize(offset);
+			_used = offset;
+		}
+
+		// Set neighbors of primitive i. Capacity must suffice. Lists 
+		// filled by Assign must be completed with Pair.
+		template<typename Iterator>
+		void Assign(size_t i, Iterator first, Iterator last)
+		{
+			auto n = (uint32_t)std::distance(first, last);
+			assert(n <= _capacities[i]);
+			std::copy(first, last, _indices.begin() + _offsets[i]);
+			_counts[i] = n;
+		}
+
+		// Sort all lists by index and link mirrored entries. Lists must 
+		// be symmetric. Since sorted, the kth neighbor of j with a lower 
+		// index is the kth such primitive to list j.
+		void Pair()
+		{
+			auto n = _offsets.size();
+
+			#pragma omp parallel for schedule(static)
+			for(int i = 0; i < (int)n; ++i)
+			{
+				auto first = _indices.begin() + _offsets[i];
+				std::sort(first, first + _counts[i]);
+			}
+
+			_cursors.assign(n, 0);
+			for(size_t i = 0; i < n; ++i)
+				for(uint32_t k = 0; k < _counts[i]; ++k)
+				{
+					auto j = _indices[_offsets[i] + k];
+					if(j < i)
+						continue;
+
+					auto m = _cursors[j]++;
+					assert(_indices[_offsets[j] + m] == i);
+					_mirrors[_offsets[i] + k] = m;
+					_mirrors[_offsets[j] + m] = k;
+				}
+		}
+
+		// Add primitives i and j to each other's lists.
+		void Link(size_t i, uint32_t j)
+		{
+			Reserve(i);
+			Reserve(j);
+
+			auto ki = _counts[i]++;
+			auto kj = _counts[j]++;
+			_indices[_offsets[i] + ki] = j;
+			_mirrors[_offsets[i] + ki] = kj;
+			_indices[_offsets[j] + kj] = (uint32_t)i;
+			_mirrors[_offsets[j] + kj] = ki;
+		}
+
+		// Remove primitives i and j from each other's lists.
+		void Unlink(size_t i, uint32_t j)
+		{
+			auto first = _indices.begin() + _offsets[i];
+			auto last = first + _counts[i];
+			auto it = std::find(first, last, j);
+			if(it == last)
+				return;
+
+			auto k = (uint32_t)(it - first);
+			auto m = _mirrors[_offsets[i] + k];
+			Erase(i, k);
+			Erase(j, m);
+		}
+
+		// Remove primitive i from all of its neighbors' lists and 
+		// clear its own. Constant time per neighbor.
+		void Detach(size_t i)
+		{
+			while(_counts[i] > 0)
+			{
+				auto k = _counts[i] - 1;
+				auto j = _indices[_offsets[i] + k];
+				auto m = _mirrors[_offsets[i] + k];
+				--_counts[i];
+				Erase(j, m);
+			}
+		}
+
+		// Check if j is a neighbor of primitive i.
+		bool Contains(size_t i, uint32_t j) const
+		{
+			auto first = _indices.begin() + _offsets[i];
+			auto last = first + _counts[i];
+			return std::find(first, last, j) != last;
+		}
+
+		// Discard all lists and lay out n empty slots. Reuses storage.
+		void Reset(size_t n)
+		{
+			_offsets.assign(n, 0);
+			_counts.assign(n, 0);
+			_capacities.assign(n, 0);
+			_indices.clear();
+			_mirrors.clear();
+			_used = 0;
+		}
+
+		// Exchange contents with another arena over the same primitives.
+		void Swap(NeighborArena& rhs)
+		{
+			assert(_primitives == rhs._primitives);
+			_indices.swap(rhs._indices);
+			_mirrors.swap(rhs._mirrors);
+			_offsets.swap(rhs._offsets);
+			_counts.swap(rhs._counts);
+			_capacities.swap(rhs._capacities);
+			std::swap(_used, rhs._used);
+		}
+
+		// Clear neighbors of primitive i without touching other lists. 
+		// Only valid if all lists are cleared or i was detached.
+		void Clear(size_t i) { _counts[i] = 0; }
+
+		// Move the slot of primitive "from" to "to" and rename "from"
+		// in its neighbors' lists through the mirrored entries. The 
+		// slot previously at "to" is discarded and must be empty.
+		void Relabel(size_t from, size_t to)
+		{
+			assert(_counts[to] == 0);
+			_used -= _capacities[to];
+			_offsets[to] = _offsets[from];
+			_counts[to] = _counts[from];
+			_capacities[to] = _capacities[from];
+			_capacities[from] = 0;
+			_counts[from] = 0;
+
+			for(uint32_t k = 0; k < _counts[to]; ++k)
+			{
+				auto j = _indices[_offsets[to] + k];
+				auto m = _mirrors[_offsets[to] + k];
+				assert(_indices[_offsets[j] + m] == from);
+				_indices[_offsets[j] + m] = (uint32_t)to;
+			}
+		}
+	};
+}
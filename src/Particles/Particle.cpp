@@ -44,6 +44,7 @@ namespace SAPHRON
 		child->SetParent(this);
 		child->SetWorld(_world);
 		_children.push_back(child);
+		TouchTopologyStamp();
 	
 		this->_pEvent.SetChild(child);
 		this->_pEvent.child_add = 1;
@@ -69,6 +70,7 @@ namespace SAPHRON
 
 			particle->ClearParent();
 			particle->SetWorld(nullptr);
+			TouchTopologyStamp();
 			
 			for(auto& o : _observers)
 				particle->RemoveObserver(o);
@@ -85,10 +87,15 @@ namespace SAPHRON
 	void Particle::RemoveFromNeighbors()
 	{
 		// Remove particle from neighbor list. 
-		for(auto& neighbor : _neighbors)
+		if(_arena != nullptr)
+			_arena->Detach(_primindex);
+		else
 		{
-			if(neighbor != NULL && neighbor != nullptr)
-				neighbor->RemoveNeighbor(this);
+			for(auto* neighbor : GetNeighbors())
+			{
+				if(neighbor != nullptr)
+					neighbor->RemoveNeighbor(this);
+			}
 		}
 
 		for(auto& c : *this)
@@ -404,4 +411,5 @@ namespace SAPHRON
 	SpeciesList Particle::_speciesList(0);
 	ParticleMap Particle::_identityList {};
 	int Particle::_nextID = 0;
+	unsigned long Particle::_nextstamp = 0;
 }
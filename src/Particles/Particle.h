@@ -2,15 +2,18 @@
 
 #include "ParticleObserver.h"
 #include "ParticleEvent.h"
+#include "NeighborArena.h"
 #include "vecmap.h"
 #include "json/json.h"
 #include "../Observers/Visitable.h"
 #include "../Connectivities/Connectivity.h"
+#include "../Properties/EPTuple.h"
 #include "../Properties/Vector3D.h"
 #include "../JSON/Serializable.h"
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -61,10 +64,15 @@ namespace SAPHRON
 		// Integer species.
 		int _speciesID;
 
-		// Neighbor list.
+		// Neighbor list (used when not stored in a neighbor arena).
 		NeighborList _neighbors;
 
-		// Bonded List.
+		// Neighbor arena of associated world.
+		NeighborArena* _arena;
+
+		// Bonded List. Unlike the neighbor list this is kept per particle 
+		// since bonds are set on blueprints outside of a world and copied 
+		// with their molecule. Only bonded particles allocate storage.
 		NeighborList _bondedneighbors;
 
 		// Particle children.
@@ -82,6 +90,32 @@ namespace SAPHRON
 		// Parent particle.
 		Particle* _parent;
 
+		// Index of particle in associated world's particle list.
+		int _worldindex;
+
+		// Index of primitive in associated world's primitive storage.
+		int _primindex;
+
+		// Energy stamp (see GetEnergyStamp).
+		unsigned long _estamp;
+
+		// Next energy stamp.
+		static unsigned long _nextstamp;
+
+		// Cached energy, the cache key and the energy stamp it is valid 
+		// for (see SetCachedEnergy).
+		struct CachedEnergy
+		{
+			unsigned long key;
+			unsigned long stamp;
+			EPTuple ep;
+		};
+
+		mutable std::unique_ptr<CachedEnergy> _ecache;
+
+		// Topology stamp (see GetTopologyStamp).
+		unsigned long _topostamp;
+
 		// Next ID counter for unique global species.
 		static int _nextID;
 
@@ -117,14 +151,12 @@ namespace SAPHRON
 		// represents the global type species for this particle.
 		Particle(const Position& pos, const Director& dir, std::string species) : 
 		_position(pos), _director(dir), _checkpoint(), _charge(0), _mass(1.0), _species(species), 
-		_speciesID(0), _neighbors(0), _bondedneighbors(0), 
-		_children(0), _observers(), _globalID(-1), _world(nullptr), _parent(nullptr),
-		_connectivities(0), _pEvent(this)
+		_speciesID(0), _neighbors(0), _arena(nullptr), _bondedneighbors(0), 
+		_children(0), _observers(), _globalID(-1), _world(nullptr), _parent(nullptr), _worldindex(-1), _primindex(-1),
+		_estamp(++_nextstamp), _ecache(nullptr), _topostamp(++_nextstamp), _connectivities(0), _pEvent(this)
 		{
 			_globalID = SetGlobalIdentifier(GetNextGlobalID());
 			SetSpecies(species);
-			_neighbors.reserve(100);
-			_bondedneighbors.reserve(10);
 			_observers.reserve(10);
 		}
 
@@ -132,14 +164,12 @@ namespace SAPHRON
 		// represents the global type species for this particle.
 		Particle(std::string species) : 
 		_position(), _director(), _checkpoint(), _charge(0), _mass(1.0), _species(species), 
-		_speciesID(0), _neighbors(0), _bondedneighbors(0), 
-		_children(0), _observers(), _globalID(-1), _world(nullptr), _parent(nullptr),
-		_connectivities(0), _pEvent(this)
+		_speciesID(0), _neighbors(0), _arena(nullptr), _bondedneighbors(0), 
+		_children(0), _observers(), _globalID(-1), _world(nullptr), _parent(nullptr), _worldindex(-1), _primindex(-1),
+		_estamp(++_nextstamp), _ecache(nullptr), _topostamp(++_nextstamp), _connectivities(0), _pEvent(this)
 		{
 			_globalID = SetGlobalIdentifier(GetNextGlobalID());
 			SetSpecies(species);
-			_neighbors.reserve(100);
-			_bondedneighbors.reserve(10);
 			_observers.reserve(10);
 		}
 
@@ -148,10 +178,10 @@ namespace SAPHRON
 		_position(particle._position), _director(particle._director),
 		_checkpoint(particle._checkpoint), _charge(particle._charge), 
 		_mass(particle._mass), _species(particle._species), _speciesID(particle._speciesID), 
-		_neighbors(particle._neighbors), _bondedneighbors(0), _children(0), 
+		_neighbors(particle._neighbors), _arena(nullptr), _bondedneighbors(0), _children(0), 
 		_observers(particle._observers), _globalID(-1),	_world(particle._world), 
-		_parent(particle._parent), _connectivities(particle._connectivities), 
-		_pEvent(this)
+		_parent(particle._parent), _worldindex(-1), _primindex(-1), _estamp(++_nextstamp), 
+		_ecache(nullptr), _topostamp(particle._topostamp), _connectivities(particle._connectivities), _pEvent(this)
 		{
 			_globalID = SetGlobalIdentifier(GetNextGlobalID());
 			for(const auto& child : particle)
@@ -173,6 +203,9 @@ namespace SAPHRON
 				}
 				++i;
 			}
+
+			// Copies have the topology of the original.
+			_topostamp = particle._topostamp;
 		}
 
 		virtual ~Particle() 
@@ -235,11 +268,14 @@ namespace SAPHRON
 		// Gets all children of a particle.
 		const ParticleList& GetChildren() const	{ return _children; }
 
-		// Gets neighbor list iterator.
-		inline NeighborList& GetNeighbors()	{ return _neighbors; }
-
-		// Gets neighbor list iterator.
-		inline const NeighborList& GetNeighbors() const	{ return _neighbors; }
+		// Gets neighbor list.
+		inline NeighborSpan GetNeighbors() const
+		{ 
+			if(_arena != nullptr)
+				return _arena->GetNeighbors(_primindex);
+			
+			return NeighborSpan(_neighbors.data(), _neighbors.size());
+		}
 
 		// Get the associated world.
 		inline World* GetWorld() const { return _world;	}
@@ -252,6 +288,28 @@ namespace SAPHRON
 				child->SetWorld(world);
 		}
 
+		// Get index of particle in the associated world's particle list.
+		// Returns -1 if it is not a top level particle in a world.
+		inline int GetWorldIndex() const { return _worldindex; }
+
+		// Set world index. This should not be used except by the world itself!
+		inline void SetWorldIndex(int index) { _worldindex = index; }
+
+		// Get index of primitive in the associated world's primitive 
+		// storage. Returns -1 if it is not stored in a world.
+		inline int GetPrimitiveIndex() const { return _primindex; }
+
+		// Set primitive index. This should not be used except by the world itself!
+		inline void SetPrimitiveIndex(int index) { _primindex = index; }
+
+		// Set the neighbor arena holding the neighbor list of a primitive. 
+		// This should not be used except by the world itself!
+		inline void SetNeighborArena(NeighborArena* arena) 
+		{ 
+			_arena = arena; 
+			_neighbors.clear();
+		}
+
 		// Get particle species.
 		inline int GetSpeciesID() const	{ return _speciesID; }
 
@@ -327,6 +385,42 @@ namespace SAPHRON
 			this->NotifyObservers();
 		}
 
+		// Gets the energy stamp of the particle. A world tracking stamps 
+		// (see World::TrackEnergyStamps) assigns a new one whenever a 
+		// change can affect the energy of the particle. Stamps are unique.
+		unsigned long GetEnergyStamp() const { return _estamp; }
+
+		// Assigns a new energy stamp.
+		void TouchEnergyStamp() { _estamp = ++_nextstamp; }
+
+		// Gets the cached energy stored under a key if it is valid for the 
+		// current energy stamp, otherwise null.
+		const EPTuple* GetCachedEnergy(unsigned long key) const
+		{
+			if(_ecache == nullptr || _ecache->key != key || _ecache->stamp != _estamp)
+				return nullptr;
+			return &_ecache->ep;
+		}
+
+		// Caches an energy under a key for the current energy stamp. A 
+		// particle holds a single entry which is owned by the particle 
+		// itself, so it never outlives it.
+		void SetCachedEnergy(unsigned long key, const EPTuple& ep) const
+		{
+			if(_ecache == nullptr)
+				_ecache.reset(new CachedEnergy{key, _estamp, ep});
+			else
+				*_ecache = CachedEnergy{key, _estamp, ep};
+		}
+
+		// Gets the topology stamp. It changes whenever the particle gains or 
+		// loses a child or a bond between its children changes. Copies keep 
+		// the stamp of the original, so equal stamps imply equal topologies.
+		unsigned long GetTopologyStamp() const { return _topostamp; }
+
+		// Assigns a new topology stamp.
+		void TouchTopologyStamp() { _topostamp = ++_nextstamp; }
+
 		// Gets a particle's position at the checkpoint.
 		const Position& GetCheckpoint() const
 		{
@@ -348,6 +442,21 @@ namespace SAPHRON
 				c->SetCheckpoint();	
 		}
 
+		// Sets the checkpoint of this particle only.
+		void SetCheckpoint(const Position& checkpoint)
+		{
+			_checkpoint = checkpoint;
+		}
+
+		// Shifts the checkpoint of the particle and its children by d.
+		void TranslateCheckpoint(const Position& d)
+		{
+			_checkpoint += d;
+
+			for(auto& c : *this)
+				c->TranslateCheckpoint(d);
+		}
+
 		// Get the particle director.
 		const Director& GetDirector() const
 		{
@@ -476,19 +585,34 @@ namespace SAPHRON
 		// Propogates to children.
 		void RemoveFromBondedNeighbors();
 
-		// Add a neighbor to neighbor list.
+		// Add a neighbor to neighbor list. Particles in a neighbor 
+		// arena can only have neighbors in the same arena, and since 
+		// arena lists are symmetric this also adds this particle to 
+		// the neighbor's list.
 		// TODO: figure out an efficient mechanism to check for duplicates 
 		// other than std::find.
 		inline void AddNeighbor(Particle* particle)
 		{
-			//auto found = std::find(_neighbors.begin(), _neighbors.end(), particle);
-			//if(found == _neighbors.end())
-			_neighbors.push_back(particle);
+			if(_arena != nullptr)
+			{
+				assert(particle->_arena == _arena);
+				_arena->Link(_primindex, particle->_primindex);
+			}
+			else
+				_neighbors.push_back(particle);
 		}
 
-		// Remove a neighbor from the neighbor list.
+		// Remove a neighbor from the neighbor list. Arena lists are 
+		// symmetric so this particle is removed from the neighbor's list.
 		inline void RemoveNeighbor(Particle* particle)
 		{
+			if(_arena != nullptr)
+			{
+				if(particle->_arena == _arena)
+					_arena->Unlink(_primindex, particle->_primindex);
+				return;
+			}
+
 			auto it = std::find(_neighbors.begin(), _neighbors.end(), particle);
 			if(it != _neighbors.end())
 			{
@@ -500,6 +624,10 @@ namespace SAPHRON
 		// Check if a particle is a neighbor.
 		inline bool IsNeighbor(const Particle& particle) const
 		{
+			if(_arena != nullptr)
+				return particle._arena == _arena && 
+				       _arena->Contains(_primindex, particle._primindex);
+
 			auto found = std::find(_neighbors.begin(), _neighbors.end(), &particle);
 			return  found != _neighbors.end();
 		}
@@ -508,7 +636,10 @@ namespace SAPHRON
 		// Propogates to children.
 		inline void ClearNeighborList() 
 		{ 
-			_neighbors.clear(); 
+			if(_arena != nullptr)
+				_arena->Clear(_primindex);
+			else
+				_neighbors.clear(); 
 			
 			for(auto& c : *this)
 				c->ClearNeighborList();
@@ -531,7 +662,11 @@ namespace SAPHRON
 		{
 			auto found = std::find(_bondedneighbors.begin(), _bondedneighbors.end(), particle);
 			if(found == _bondedneighbors.end())
+			{
 				_bondedneighbors.push_back(particle);
+				if(_parent != nullptr)
+					_parent->TouchTopologyStamp();
+			}
 		}
 
 		// Remove a bonded neighbor from the bonded neighbor list.
@@ -541,10 +676,17 @@ namespace SAPHRON
 				std::remove(_bondedneighbors.begin(), _bondedneighbors.end(), particle), 
 				_bondedneighbors.end()
 			);
+			if(_parent != nullptr)
+				_parent->TouchTopologyStamp();
 		}
 
 		// Clear the bonded neighbor list.
-		inline void ClearBondedNeighborList() { _bondedneighbors.clear(); }
+		inline void ClearBondedNeighborList() 
+		{ 
+			_bondedneighbors.clear(); 
+			if(_parent != nullptr)
+				_parent->TouchTopologyStamp();
+		}
 
 		// Check if a particle is a bonded neighbor.
 		inline bool IsBondedNeighbor(Particle* particle) const
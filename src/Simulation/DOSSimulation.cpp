@@ -1,7 +1,11 @@
 #include "DOSSimulation.h"
+#include "../Utils/Profiler.h"
 
 namespace SAPHRON
 {
+	// Profiler section.
+	static const ProfileHandle ProfileMoves = Profiler::Instance().Register("moves");
+
 	void DOSSimulation::Iterate()
 	{
 		_flatness = _hist->CalculateFlatness();
@@ -15,7 +19,10 @@ namespace SAPHRON
 				auto* move = _mmanager->SelectRandomMove();
 
 				// Perform move. 
-				move->Perform(world, _ffmanager, _orderp, MoveOverride::None);
+				{
+					ProfileScope scope(ProfileMoves);
+					move->Perform(world, _ffmanager, _orderp, MoveOverride::None);
+				}
 
 				_opval = _orderp->EvaluateOrderParameter(*world);
 				// Only begin recording after equilibration period.
@@ -27,6 +34,9 @@ namespace SAPHRON
 				}
 			}
 
+			// Adjust neighbor list skin if requested.
+			_wmanager->GetWorld(0)->TuneSkinThickness();
+
 			// Reset histogram if desired.
 			if(this->GetIteration() && _hreset && (this->GetIteration() % _hreset == 0))
 				_hist->ResetHistogram();
@@ -35,6 +45,9 @@ namespace SAPHRON
 			UpdateAcceptances();
 			this->IncrementIterations();
 
+			SimEvent event(this, this->GetIteration());
+			UpdatePressures(event);
+
 			#ifdef MULTI_WALKER
 			// Sync periodically.
 			if(this->GetIteration() % _syncfreq == 0)
@@ -46,17 +59,20 @@ namespace SAPHRON
 
 			if(_comm.rank() == 0)
 			#endif
-			this->NotifyObservers(SimEvent(this, this->GetIteration()));
+			this->NotifyObservers(event);
 		}
 	}
 
 	// Run the DOS algorithm for a specified number of scale factor reductions.
 	void DOSSimulation::Run(int iterations)
 	{
+		SimEvent event(this, this->GetIteration());
+		UpdatePressures(event);
+
 		#ifdef MULTI_WALKER
 		if(_comm.rank() == 0)
 		#endif
-		this->NotifyObservers(SimEvent(this, this->GetIteration()));
+		this->NotifyObservers(event);
 
 		// Cheap hack. Slaves iterate forever.
 		#ifdef MULTI_WALKER
@@ -80,9 +96,12 @@ namespace SAPHRON
 			#endif
 		}
 
+		event = SimEvent(this, this->GetIteration(), true);
+		UpdatePressures(event);
+
 		#ifdef MULTI_WALKER
 		if(_comm.rank() == 0)
 		#endif
-		this->NotifyObservers(SimEvent(this, this->GetIteration(), true));
+		this->NotifyObservers(event);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "SimBuilder.h"
 #include "../JSON/JSONLoader.h"
+#include "../ForceFields/EwaldFF.h"
+#include "../ForceFields/TabulatedFF.h"
 #include "config.h"
+#include <sstream>
 
 #ifdef MULTI_WALKER
 #include <boost/mpi.hpp>
@@ -169,7 +172,8 @@ namespace SAPHRON
 			ForceField::BuildForceFields(
 					root.get("forcefields", Json::arrayValue), 
 					&_ffm, 
-					_forcefields);
+					_forcefields, 
+					_worlds);
 		} catch(BuildException& e) {
 			DumpErrorsToConsole(e.GetErrors(), _notw);
 			return false;
@@ -180,6 +184,44 @@ namespace SAPHRON
 
 		notices.push_back("Initialized " +  to_string(_forcefields.size()) + " forcefield(s).");
 
+		// Report interpolation errors of tabulated forcefields.
+		for(auto& ff : _forcefields)
+		{
+			const ForceField* base = ff;
+			if(auto* tff = dynamic_cast<TabulatedFF*>(ff))
+			{
+				base = tff->GetForceField();
+				Json::Value json;
+				tff->GetForceField()->Serialize(json);
+				std::ostringstream ss;
+				ss << std::scientific << std::setprecision(2) 
+				   << "Tabulated " << json["type"].asString() << " forcefield on " 
+				   << tff->GetPoints() << " points (max. error " 
+				   << tff->GetMaxEnergyError() << " energy, " 
+				   << tff->GetMaxVirialError() << " virial).";
+				notices.push_back(ss.str());
+			}
+
+			// Report tuned Ewald parameters, which may be tabulated.
+			if(auto* eff = dynamic_cast<const EwaldFF*>(base))
+			{
+				if(eff->GetTolerance() > 0)
+				{
+					Json::Value json;
+					eff->Serialize(json);
+					std::ostringstream ss;
+					ss << "Tuned Ewald to relative error " << eff->GetTolerance() 
+					   << ": alpha " << json["alpha"].asDouble() << ", kmax [" 
+					   << json["kmax"][0].asInt() << ", " << json["kmax"][1].asInt() << ", " 
+					   << json["kmax"][2].asInt() << "], rcut [";
+					for(Json::ArrayIndex i = 0; i < json["rcut"].size(); ++i)
+						ss << (i ? ", " : "") << json["rcut"][i].asDouble();
+					ss << "] \u212B.";
+					notices.push_back(ss.str());
+				}
+			}
+		}
+
 		DumpNoticesToConsole(notices, "",_notw);
 		notices.clear();
 
@@ -10,7 +10,7 @@ namespace SAPHRON
 	{
 		private:
 			unsigned int simulation_mask = 31;
-			unsigned int world_mask = 127;
+			unsigned int world_mask = 255;
 			unsigned int energy_mask = 255;
 			unsigned int pressure_mask = 255;
 			unsigned int histogram_mask = 63;
@@ -53,6 +53,7 @@ namespace SAPHRON
 					unsigned int world_composition: 1;
 					unsigned int world_energy : 1;
 					unsigned int world_chem_pot : 1;
+					unsigned int world_skin : 1;
 				};
 				
 				unsigned int world;
@@ -145,6 +146,7 @@ namespace SAPHRON
 					if(world_composition) json["world_composition"] = 1;
 					if(world_energy) json["world_energy"] = 1;
 					if(world_chem_pot) json["world_chem_pot"] = 1;
+					if(world_skin) json["world_skin"] = 1;
 				}
 
 				if(energy_components == energy_mask)
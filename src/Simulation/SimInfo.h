@@ -1,6 +1,7 @@
 #pragma once 
 
-#include "../Utils/Timer.h"
+#include <map>
+#include <string>
 
 namespace SAPHRON
 {
@@ -17,14 +18,18 @@ namespace SAPHRON
 	{
 	private:
 		SimUnits _units;
-		Timer _timer;
 
-		// Name map for timer names.
+		// Event counters.
+		std::map<std::string, long> _counters;
+
+		// Name map for profiler sections and counters.
 		std::map<std::string, std::string> _namemap = {
 			{"nlist", "Neighbor list generation"},
-			{"total", "Total"},
+			{"moves", "Moves"},
 			{"e_inter", "Intermolecular energy"},
-			{"e_intra", "Intramolecular energy"}
+			{"e_intra", "Intramolecular energy"},
+			{"nlist_sort", "Spatial reorderings"},
+			{"nlist_reuse", "Neighbor list reuses"}
 		};
 
 		/***************************
@@ -64,7 +69,7 @@ namespace SAPHRON
 		double _epconv = 1.0;
 
 	public:
-		SimInfo() : _timer() {}
+		SimInfo() : _counters() {}
 
 		// Get singleton (I know, I know...) instance of 
 		// SimInfo.
@@ -94,13 +99,11 @@ namespace SAPHRON
 			}
 		}
 
-		// Start a timer.
-		void StartTimer(const std::string& name) { _timer.PressStart(name); }
-
-		// Add time to timer. 
-		void AddTime(const std::string& name) { _timer.AddTime(name); }
+		// Increment a named event counter.
+		void IncrementCounter(const std::string& name) { ++_counters[name]; }
 
-		const TimerMap& GetTimerMap() const { return _timer.GetTimerMap(); }
+		// Get event counter map.
+		const std::map<std::string, long>& GetCounterMap() const { return _counters; }
 
 		std::string ResolveTimerName(const std::string& name) const
 		{
@@ -24,4 +24,16 @@ namespace SAPHRON
 		for(auto& observer : _observers)
 			observer->Update(event);
 	}
+
+	bool SimObservable::ObservesPressure(const SimEvent& event) const
+	{
+		for(auto& observer : _observers)
+		{
+			auto flags = observer->GetFlags();
+			if((flags.world_pressure || flags.pressure_tensor) && observer->WillObserve(event))
+				return true;
+		}
+
+		return false;
+	}
 }
@@ -30,5 +30,8 @@ namespace SAPHRON
 
 		// Notify registered observers of a change.
 		void NotifyObservers(const SimEvent& event);
+
+		// Will any observer record world pressures on an event?
+		bool ObservesPressure(const SimEvent& event) const;
 	};
 }
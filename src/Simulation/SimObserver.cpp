@@ -29,6 +29,7 @@ namespace SAPHRON
 		flags.world_composition = json.get("world_composition", 0).asUInt();
 		flags.world_energy = json.get("world_energy", 0).asUInt();
 		flags.world_chem_pot = json.get("world_chem_pot", 0).asUInt();
+		flags.world_skin = json.get("world_skin", 0).asUInt();
 		flags.eintervdw = json.get("energy_intervdw", 0).asUInt();
 		flags.eintravdw = json.get("energy_intravdw", 0).asUInt();
 		flags.einterelect = json.get("energy_interelect", 0).asUInt();
@@ -84,7 +85,7 @@ namespace SAPHRON
 	void SimObserver::Update(const SimEvent& e)
 	{
 		// Only lock and proceed if we have to.
-		if(e.GetIteration() % _frequency == 0 || e.ForceObserve())
+		if(WillObserve(e))
 		{
 			_mutex.lock();
 			_event = e;
@@ -57,6 +57,12 @@ namespace SAPHRON
 			// Update observer when simulation has changed.
 			void Update(const SimEvent& e);
 
+			// Will the observer act on an event?
+			bool WillObserve(const SimEvent& e) const
+			{
+				return e.GetIteration() % _frequency == 0 || e.ForceObserve();
+			}
+
 			// Get flags.
 			SimFlags GetFlags() const { return Flags; }
 
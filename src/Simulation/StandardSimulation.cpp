@@ -1,7 +1,11 @@
 #include "StandardSimulation.h"
+#include "../Utils/Profiler.h"
 
 namespace SAPHRON
 {
+	// Profiler section.
+	static const ProfileHandle ProfileMoves = Profiler::Instance().Register("moves");
+
 	inline void StandardSimulation::Iterate()
 	{
 		_mmanager->ResetMoveAcceptances();
@@ -10,25 +14,36 @@ namespace SAPHRON
 		for(int i = 0; i < GetMovesPerIteration(); ++i)
 		{
 			auto* move = _mmanager->SelectRandomMove();
+			ProfileScope scope(ProfileMoves);
 			move->Perform(_wmanager, _ffmanager, MoveOverride::None);
 		}
+
+		// Adjust neighbor list skins if requested.
+		for(auto& world : *_wmanager)
+			world->TuneSkinThickness();
 		
 		UpdateAcceptances();
 		this->IncrementIterations();
 
+		SimEvent event(this, this->GetIteration());
+		UpdatePressures(event);
+
 		#ifdef MULTI_WALKER
 		if(_comm.rank() == 0)
 		#endif
-		this->NotifyObservers(SimEvent(this, this->GetIteration()));
+		this->NotifyObservers(event);
 	}
 
 	// Run the NVT ensemble for a specified number of iterations.
 	void StandardSimulation::Run(int iterations)
 	{
+		SimEvent event(this, this->GetIteration());
+		UpdatePressures(event);
+
 		#ifdef MULTI_WALKER
 		if(_comm.rank() == 0)
 		#endif
-		this->NotifyObservers(SimEvent(this, this->GetIteration()));
+		this->NotifyObservers(event);
 	
 		for(int i = 0; i < iterations; ++i)
 			Iterate();
@@ -35,6 +35,18 @@ namespace SAPHRON
 				_accmap[move->GetName()] = move->GetAcceptanceRatio();
 		}
 
+		// Recomputes pressures left out of date by energy-only 
+		// moves if an observer records them on an event.
+		inline void UpdatePressures(const SimEvent& event)
+		{
+			if(!this->ObservesPressure(event))
+				return;
+
+			for(auto& world : *_wmanager)
+				if(!world->IsPressureValid())
+					world->SetPressure(_ffmanager->EvaluateEnergy(*world).pressure);
+		}
+
 		void Iterate();
 
 	protected:
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace SAPHRON
+{
+	// In place complex discrete Fourier transform of a fixed length.
+	// Powers of two use an iterative radix-2 transform. Other lengths
+	// use Bluestein's algorithm, which writes the transform as a
+	// convolution evaluated with radix-2 transforms of length m >= 2n - 1.
+	// The inverse is not normalized.
+	class FFT1D
+	{
+	private:
+		int _n;
+
+		// Length of the radix-2 transform (n for powers of two).
+		int _m;
+
+		// Twiddle factors exp(-2*pi*i*k/m).
+		std::vector<std::complex<double>> _w;
+
+		// Bit reversal permutation of length m.
+		std::vector<int> _rev;
+
+		// Chirp exp(-i*pi*k^2/n) and transformed convolution kernel 
+		// (Bluestein only).
+		std::vector<std::complex<double>> _chirp, _kernel;
+
+		// In place radix-2 transform of m values.
+		void Radix2(std::complex<double>* a, int sign) const
+		{
+			for(int k = 0; k < _m; ++k)
+				if(k < _rev[k])
+					std::swap(a[k], a[_rev[k]]);
+
+			for(int len = 2; len <= _m; len <<= 1)
+			{
+				int half = len/2, step = _m/len;
+				for(int i = 0; i < _m; i += len)
+					for(int j = 0; j < half; ++j)
+					{
+						auto w = _w[j*step];
+						if(sign > 0)
+							w = std::conj(w);
+						auto u = a[i + j];
+						auto v = a[i + j + half]*w;
+						a[i + j] = u + v;
+						a[i + j + half] = u - v;
+					}
+			}
+		}
+
+	public:
+		FFT1D(int n) : _n(n), _m(1), _w(), _rev(), _chirp(), _kernel()
+		{
+			bool pow2 = n > 0 && (n & (n - 1)) == 0;
+			int bits = 0;
+			while((1 << bits) < (pow2 ? n : 2*n - 1))
+				++bits;
+			_m = 1 << bits;
+
+			_w.resize(_m);
+			for(int k = 0; k < _m; ++k)
+				_w[k] = std::polar(1., -2.*M_PI*k/_m);
+
+			_rev.resize(_m);
+			for(int k = 0; k < _m; ++k)
+			{
+				int r = 0;
+				for(int b = 0; b < bits; ++b)
+					if(k & (1 << b))
+						r |= 1 << (bits - 1 - b);
+				_rev[k] = r;
+			}
+
+			if(pow2)
+				return;
+
+			// k^2 is reduced modulo 2n to keep the phase accurate.
+			_chirp.resize(n);
+			_kernel.assign(_m, 0);
+			for(int k = 0; k < n; ++k)
+			{
+				_chirp[k] = std::polar(1., -M_PI*(((long)k*k) % (2*n))/n);
+				_kernel[k] = std::conj(_chirp[k]);
+				if(k > 0)
+					_kernel[_m - k] = _kernel[k];
+			}
+			Radix2(&_kernel[0], -1);
+		}
+
+		// Transforms n contiguous values. Sign -1 is the forward transform,
+		// +1 the inverse. Scratch is resized as needed.
+		void Transform(std::complex<double>* a, int sign,
+		               std::vector<std::complex<double>>& scratch) const
+		{
+			if(_m == _n)
+			{
+				Radix2(a, sign);
+				return;
+			}
+
+			// The inverse is the conjugate of the forward transform of 
+			// the conjugate.
+			scratch.assign(_m, 0);
+			for(int k = 0; k < _n; ++k)
+				scratch[k] = (sign < 0 ? a[k] : std::conj(a[k]))*_chirp[k];
+
+			Radix2(&scratch[0], -1);
+			for(int k = 0; k < _m; ++k)
+				scratch[k] *= _kernel[k];
+			Radix2(&scratch[0], 1);
+
+			for(int k = 0; k < _n; ++k)
+			{
+				auto x = scratch[k]*_chirp[k]/(double)_m;
+				a[k] = (sign < 0) ? x : std::conj(x);
+			}
+		}
+
+		int GetSize() const { return _n; }
+	};
+
+	// Complex discrete Fourier transform on an nx*ny*nz grid stored
+	// with z fastest, i.e. index (x*ny + y)*nz + z. Lines along each
+	// axis are transformed in parallel. The inverse is not normalized.
+	class FFT3D
+	{
+	private:
+		int _nx, _ny, _nz;
+		FFT1D _fx, _fy, _fz;
+
+		// Transforms all lines along one axis given the line length,
+		// stride between elements and the start of each line.
+		static void TransformLines(const FFT1D& fft, std::complex<double>* data,
+		                           int stride, const std::vector<int>& starts, int sign)
+		{
+			int n = fft.GetSize();
+			int nl = starts.size();
+
+			#pragma omp parallel
+			{
+				std::vector<std::complex<double>> line(n), scratch;
+
+				#pragma omp for schedule(static)
+				for(int l = 0; l < nl; ++l)
+				{
+					auto* p = data + starts[l];
+					for(int k = 0; k < n; ++k)
+						line[k] = p[k*stride];
+					fft.Transform(&line[0], sign, scratch);
+					for(int k = 0; k < n; ++k)
+						p[k*stride] = line[k];
+				}
+			}
+		}
+
+		void Transform(std::vector<std::complex<double>>& data, int sign) const
+		{
+			std::vector<int> starts;
+
+			// z lines.
+			for(int i = 0; i < _nx*_ny; ++i)
+				starts.push_back(i*_nz);
+			TransformLines(_fz, &data[0], 1, starts, sign);
+
+			// y lines.
+			starts.clear();
+			for(int i = 0; i < _nx; ++i)
+				for(int k = 0; k < _nz; ++k)
+					starts.push_back(i*_ny*_nz + k);
+			TransformLines(_fy, &data[0], _nz, starts, sign);
+
+			// x lines.
+			starts.clear();
+			for(int j = 0; j < _ny*_nz; ++j)
+				starts.push_back(j);
+			TransformLines(_fx, &data[0], _ny*_nz, starts, sign);
+		}
+
+	public:
+		FFT3D(int nx, int ny, int nz) :
+		_nx(nx), _ny(ny), _nz(nz), _fx(nx), _fy(ny), _fz(nz)
+		{
+		}
+
+		// Forward transform, sum of f(r)*exp(-2*pi*i*k.r/n).
+		void Forward(std::vector<std::complex<double>>& data) const
+		{
+			Transform(data, -1);
+		}
+
+		// Inverse transform, sum of f(k)*exp(2*pi*i*k.r/n).
+		void Inverse(std::vector<std::complex<double>>& data) const
+		{
+			Transform(data, 1);
+		}
+
+		// Get total number of grid points.
+		int GetSize() const { return _nx*_ny*_nz; }
+	};
+}
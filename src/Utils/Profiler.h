@@ -0,0 +1,245 @@
+#pragma once
+
+#include "config.h"
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SAPHRON
+{
+	// Handle of a profiler section.
+	typedef int ProfileHandle;
+
+	// Timing of a profiler section within its enclosing section.
+	struct ProfileEntry
+	{
+		// Section name.
+		std::string name;
+
+		// Nesting depth (0 for top level sections).
+		int depth;
+
+		// Total elapsed time (seconds).
+		double seconds;
+
+		// Number of times the section was timed.
+		long calls;
+	};
+
+	// Hierarchical profiler. Sections are registered once by name and
+	// timed through integer handles using ProfileScope. Each thread
+	// records into its own call tree, which are merged by section path
+	// when a report is requested. Timing is compiled in only if
+	// SAPHRON_PROFILE is defined.
+	class Profiler
+	{
+	private:
+		typedef std::chrono::steady_clock Clock;
+
+		// Node of a call tree.
+		struct Node
+		{
+			ProfileHandle handle;
+			int parent;
+			std::vector<int> children;
+			Clock::time_point start;
+			Clock::duration elapsed;
+			long calls;
+		};
+
+		// Call tree and active node of a thread. Padded so threads
+		// do not share cache lines.
+		struct ThreadData
+		{
+			std::vector<Node> nodes;
+			int current;
+			char padding[64];
+		};
+
+		// Registered section names.
+		std::vector<std::string> _names;
+		std::mutex _mutex;
+
+		// Per thread call trees, added when a thread first times a section.
+		// A deque keeps existing trees in place while it grows.
+		std::deque<ThreadData> _threads;
+
+		// Construction time.
+		Clock::time_point _t0;
+
+		// Creates an empty call tree (root only).
+		static void ResetTree(ThreadData& data)
+		{
+			data.nodes.assign(1, Node{-1, -1, {}, Clock::time_point(), Clock::duration::zero(), 0});
+			data.current = 0;
+		}
+
+		// Gets child of node with handle h in tree, creating it if needed.
+		static int GetChild(std::vector<Node>& nodes, int node, ProfileHandle h)
+		{
+			for(auto c : nodes[node].children)
+				if(nodes[c].handle == h)
+					return c;
+
+			nodes.push_back(Node{h, node, {}, Clock::time_point(), Clock::duration::zero(), 0});
+			int c = (int)nodes.size() - 1;
+			nodes[node].children.push_back(c);
+			return c;
+		}
+
+		// Merges subtree of src rooted at s into dst at d.
+		static void Merge(const std::vector<Node>& src, int s, std::vector<Node>& dst, int d)
+		{
+			for(auto c : src[s].children)
+			{
+				int m = GetChild(dst, d, src[c].handle);
+				dst[m].elapsed += src[c].elapsed;
+				dst[m].calls += src[c].calls;
+				Merge(src, c, dst, m);
+			}
+		}
+
+		// Flattens merged tree in depth first order.
+		void Flatten(const std::vector<Node>& nodes, int node, int depth,
+		             std::vector<ProfileEntry>& entries) const
+		{
+			for(auto c : nodes[node].children)
+			{
+				auto& n = nodes[c];
+				entries.push_back(ProfileEntry{_names[n.handle], depth,
+					std::chrono::duration<double>(n.elapsed).count(), n.calls});
+				Flatten(nodes, c, depth + 1, entries);
+			}
+		}
+
+		// Gets the call tree of the calling thread, creating it on first 
+		// use. Threads are told apart by thread local storage since OpenMP 
+		// thread numbers repeat across nested teams.
+		ThreadData& GetThreadData()
+		{
+			thread_local ThreadData* data = nullptr;
+			if(data == nullptr)
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_threads.emplace_back();
+				data = &_threads.back();
+				ResetTree(*data);
+			}
+			return *data;
+		}
+
+		Profiler() : _names(), _mutex(), _threads(), _t0(Clock::now())
+		{
+		}
+
+	public:
+		// Get singleton instance of profiler.
+		static Profiler& Instance()
+		{
+			static Profiler instance;
+			return instance;
+		}
+
+		// Registers a section and returns its handle. Registering an
+		// existing name returns the same handle. Meant to be called once
+		// per call site, e.g. to initialize a static handle.
+		ProfileHandle Register(const std::string& name)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for(size_t i = 0; i < _names.size(); ++i)
+				if(_names[i] == name)
+					return (ProfileHandle)i;
+
+			_names.push_back(name);
+			return (ProfileHandle)_names.size() - 1;
+		}
+
+		// Starts section h within the active section of the calling thread.
+		inline void Start(ProfileHandle h)
+		{
+			auto& data = GetThreadData();
+			int c = GetChild(data.nodes, data.current, h);
+			data.nodes[c].start = Clock::now();
+			data.current = c;
+		}
+
+		// Stops the active section of the calling thread.
+		inline void Stop()
+		{
+			auto& data = GetThreadData();
+			auto& node = data.nodes[data.current];
+			node.elapsed += Clock::now() - node.start;
+			++node.calls;
+			data.current = node.parent;
+		}
+
+		// Gets the merged timings of all threads in depth first order.
+		// Must not be called while sections are being timed.
+		std::vector<ProfileEntry> GetReport() const
+		{
+			std::vector<Node> merged;
+			merged.push_back(Node{-1, -1, {}, Clock::time_point(), Clock::duration::zero(), 0});
+			for(auto& t : _threads)
+				Merge(t.nodes, 0, merged, 0);
+
+			std::vector<ProfileEntry> entries;
+			Flatten(merged, 0, 0, entries);
+			return entries;
+		}
+
+		// Gets the total time recorded for section h over all threads
+		// and enclosing sections (seconds).
+		double GetTotal(ProfileHandle h) const
+		{
+			Clock::duration total = Clock::duration::zero();
+			for(auto& t : _threads)
+				for(auto& n : t.nodes)
+					if(n.handle == h)
+						total += n.elapsed;
+
+			return std::chrono::duration<double>(total).count();
+		}
+
+		// Clears all recorded timings. Handles remain valid. Must not be 
+		// called while sections are being timed.
+		void Reset()
+		{
+			for(auto& t : _threads)
+				ResetTree(t);
+			_t0 = Clock::now();
+		}
+
+		// Get time elapsed since construction or reset (seconds).
+		double GetElapsed() const
+		{
+			return std::chrono::duration<double>(Clock::now() - _t0).count();
+		}
+	};
+
+	// Times a profiler section for the lifetime of the object. Compiles
+	// to nothing unless SAPHRON_PROFILE is defined.
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(ProfileHandle h)
+		{
+			#ifdef SAPHRON_PROFILE
+			Profiler::Instance().Start(h);
+			#else
+			(void)h;
+			#endif
+		}
+
+		~ProfileScope()
+		{
+			#ifdef SAPHRON_PROFILE
+			Profiler::Instance().Stop();
+			#endif
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+	};
+}
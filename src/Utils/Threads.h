@@ -0,0 +1,28 @@
+#pragma once
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace SAPHRON
+{
+	// Get the current thread number.
+	inline int GetThreadNumber()
+	{
+		#ifdef _OPENMP
+		return omp_get_thread_num();
+		#else
+		return 0;
+		#endif
+	}
+
+	// Get the maximum number of threads.
+	inline int GetMaxThreads()
+	{
+		#ifdef _OPENMP
+		return omp_get_max_threads();
+		#else
+		return 1;
+		#endif
+	}
+}
@@ -1,13 +1,20 @@
 #include "World.h"
 #include "../Simulation/SimException.h"
 #include "../Validator/ObjectRequirement.h"
+#include "../Utils/Profiler.h"
+#include "../Utils/Threads.h"
 #include "schema.h"
 #include <random>
+#include <cmath>
 
 using namespace Json;
 
 namespace SAPHRON
 {
+	// Profiler sections.
+	static const ProfileHandle ProfileNlist = Profiler::Instance().Register("nlist");
+	static const ProfileHandle ProfileInter = Profiler::Instance().Register("e_inter");
+
 	void World::AddParticleComposition(Particle* particle)
 	{
 		int id = particle->GetSpeciesID();
@@ -18,9 +25,14 @@ namespace SAPHRON
 
 		++_composition[id];
 
+		// Top level particles are indexed by species.
+		if(IsStoredParticle(particle))
+			AddToSpeciesList(_speciesparticles, _speciespos, 
+							 particle, id, particle->GetWorldIndex());
+
 		// If it's a primitive, add it to the primitives list. 
 		if(!particle->HasChildren())
-			_primitives.push_back(particle);
+			AddPrimitive(particle);
 
 		for(auto& child : particle->GetChildren())
 			AddParticleComposition(child);
@@ -32,16 +44,97 @@ namespace SAPHRON
 		assert(_composition.size() >= id);
 		--_composition[id];
 
+		if(IsStoredParticle(particle))
+			RemoveFromSpeciesList(_speciesparticles, _speciespos, 
+								  &Particle::GetWorldIndex, id, particle->GetWorldIndex());
+
 		if(!particle->HasChildren())
-			_primitives.erase(
-				std::remove(_primitives.begin(), _primitives.end(), particle),
-				_primitives.end()
-			);
+			RemovePrimitive(particle);
 
 		for(auto& child : particle->GetChildren())
 			RemoveParticleComposition(child);
 	}
 
+	void World::AddPrimitive(Particle* particle)
+	{
+		_nlistsaved = false;
+		particle->SetPrimitiveIndex((int)_primitives.size());
+		_primitives.push_back(particle);
+		_arena.Push();
+		particle->SetNeighborArena(&_arena);
+
+		auto n = _primitives.size();
+		_soa.x.resize(n);
+		_soa.y.resize(n);
+		_soa.z.resize(n);
+		_soa.ux.resize(n);
+		_soa.uy.resize(n);
+		_soa.uz.resize(n);
+		_soa.q.resize(n);
+		_soa.species.resize(n);
+		SyncPrimitive(particle);
+		LogChargeChange(0, particle->GetPosition(), particle->GetCharge(), particle->GetPosition());
+
+		_primspeciespos.push_back(-1);
+		AddToSpeciesList(_speciesprimitives, _primspeciespos, 
+						 particle, particle->GetSpeciesID(), n - 1);
+
+		if(_cellsvalid)
+			AddToCell(particle);
+	}
+
+	void World::RemovePrimitive(Particle* particle)
+	{
+		if(!IsStoredPrimitive(particle))
+			return;
+
+		_nlistsaved = false;
+		int i = particle->GetPrimitiveIndex();
+		LogChargeChange(particle->GetCharge(), particle->GetPosition(), 0, particle->GetPosition());
+		RemoveFromSpeciesList(_speciesprimitives, _primspeciespos, 
+							  &Particle::GetPrimitiveIndex, particle->GetSpeciesID(), i);
+
+		// Neighbors refer to primitives by index so detach it first.
+		particle->RemoveFromNeighbors();
+		particle->ClearNeighborList();
+
+		// Move last primitive into the vacated slot.
+		int last = (int)_primitives.size() - 1;
+		if(i != last)
+		{
+			_arena.Relabel(last, i);
+			_primitives[i] = _primitives[last];
+			_primitives[i]->SetPrimitiveIndex(i);
+			_primspeciespos[i] = _primspeciespos[last];
+			_soa.x[i] = _soa.x[last];
+			_soa.y[i] = _soa.y[last];
+			_soa.z[i] = _soa.z[last];
+			_soa.ux[i] = _soa.ux[last];
+			_soa.uy[i] = _soa.uy[last];
+			_soa.uz[i] = _soa.uz[last];
+			_soa.q[i] = _soa.q[last];
+			_soa.species[i] = _soa.species[last];
+		}
+
+		_primitives.pop_back();
+		_arena.Pop();
+		_primspeciespos.pop_back();
+		_soa.x.pop_back();
+		_soa.y.pop_back();
+		_soa.z.pop_back();
+		_soa.ux.pop_back();
+		_soa.uy.pop_back();
+		_soa.uz.pop_back();
+		_soa.q.pop_back();
+		_soa.species.pop_back();
+
+		particle->SetPrimitiveIndex(-1);
+		particle->SetNeighborArena(nullptr);
+
+		if(_cellsvalid)
+			RemoveFromCell(particle, particle->GetPosition());
+	}
+
 	void World::ModifyParticleComposition(const ParticleEvent& pEvent)
 	{
 		int oldID = pEvent.GetOldSpecies();
@@ -53,6 +146,23 @@ namespace SAPHRON
 			_composition.resize(id + 1, 0);
 
 		++_composition[id];
+
+		auto* particle = pEvent.GetParticle();
+		if(IsStoredParticle(particle))
+		{
+			int i = particle->GetWorldIndex();
+			RemoveFromSpeciesList(_speciesparticles, _speciespos, 
+								  &Particle::GetWorldIndex, oldID, i);
+			AddToSpeciesList(_speciesparticles, _speciespos, particle, id, i);
+		}
+
+		if(IsStoredPrimitive(particle))
+		{
+			int i = particle->GetPrimitiveIndex();
+			RemoveFromSpeciesList(_speciesprimitives, _primspeciespos, 
+								  &Particle::GetPrimitiveIndex, oldID, i);
+			AddToSpeciesList(_speciesprimitives, _primspeciespos, particle, id, i);
+		}
 	}
 
 	inline void World::AddNeighbor(Particle* pi, Particle* pj)
@@ -65,10 +175,12 @@ namespace SAPHRON
 		Position rij = pi->GetPosition() - pj->GetPosition();
 		ApplyMinimumImage(&rij);
 
+		// Record pair for assembly.
 		if(fdot(rij,rij) <= _ncutsq)
 		{
-			pj->AddNeighbor(pi);
-			pi->AddNeighbor(pj);
+			auto& buffer = _nbrbuf[GetThreadNumber()];
+			buffer.push_back(pi->GetPrimitiveIndex());
+			buffer.push_back(pj->GetPrimitiveIndex());
 		}
 	}
 
@@ -129,13 +241,163 @@ namespace SAPHRON
 		}
 	}
 
+	// Spreads the lower 10 bits of x so there are two zero 
+	// bits between each.
+	inline static uint32_t SpreadBits(uint32_t x)
+	{
+		x &= 0x3ff;
+		x = (x | (x << 16)) & 0x030000ff;
+		x = (x | (x << 8)) & 0x0300f00f;
+		x = (x | (x << 4)) & 0x030c30c3;
+		x = (x | (x << 2)) & 0x09249249;
+		return x;
+	}
+
+	void World::SortPrimitives()
+	{
+		int n = GetPrimitiveCount();
+
+		// Morton keys on a 1024^3 grid spanning the box.
+		std::vector<std::pair<uint32_t, int>> keys(n);
+		#pragma omp parallel for schedule(static)
+		for(int i = 0; i < n; ++i)
+		{
+			double r[3] = {_soa.x[i], _soa.y[i], _soa.z[i]};
+			uint32_t c[3];
+			for(int d = 0; d < 3; ++d)
+			{
+				int k = ffloor(1024.*r[d]/_H(d,d));
+				c[d] = std::min(std::max(k, 0), 1023);
+			}
+			keys[i] = {SpreadBits(c[0]) | (SpreadBits(c[1]) << 1) | (SpreadBits(c[2]) << 2), i};
+		}
+
+		std::sort(keys.begin(), keys.end());
+
+		ParticleList primitives(n);
+		for(int i = 0; i < n; ++i)
+			primitives[i] = _primitives[keys[i].second];
+		
+		_primitives.swap(primitives);
+		for(int i = 0; i < n; ++i)
+		{
+			_primitives[i]->SetPrimitiveIndex(i);
+			SyncPrimitive(_primitives[i]);
+		}
+
+		for(auto& list : _speciesprimitives)
+			for(size_t j = 0; j < list.size(); ++j)
+				_primspeciespos[list[j]->GetPrimitiveIndex()] = j;
+	}
+
+	void World::BuildCells()
+	{
+		// Cells must be at least as large as the neighbor list cutoff.
+		for(int d = 0; d < 3; ++d)
+		{
+			_ncells[d] = (_ncut > 0) ? std::max(1, (int)(_H(d,d)/_ncut)) : 1;
+			_cellsize[d] = _H(d,d)/_ncells[d];
+		}
+
+		// Clear cells but keep their storage around.
+		_cells.resize(_ncells[0]*_ncells[1]*_ncells[2]);
+		for(auto& cell : _cells)
+			cell.clear();
+
+		// Bin from contiguous coordinate storage.
+		for(size_t i = 0; i < _primitives.size(); ++i)
+			_cells[GetCellIndex(_soa.x[i], _soa.y[i], _soa.z[i])].push_back(_primitives[i]);
+
+		_cellsvalid = true;
+	}
+
+	void World::AddToCell(Particle* particle)
+	{
+		_cells[GetCellIndex(particle->GetPosition())].push_back(particle);
+	}
+
+	bool World::RemoveFromCell(Particle* particle, const Position& pos)
+	{
+		auto& cell = _cells[GetCellIndex(pos)];
+		auto it = std::find(cell.begin(), cell.end(), particle);
+		if(it == cell.end())
+			return false;
+
+		std::swap(*it, cell.back());
+		cell.pop_back();
+		return true;
+	}
+
+	// Adds all neighbors of primitive pi found in the surrounding cells 
+	// to its neighbor list and pi to theirs. If a buffer is supplied, 
+	// neighbor indices are appended to it instead which makes it safe 
+	// to call in parallel for different primitives.
+	void World::AddCellNeighbors(Particle* pi, std::vector<uint32_t>* buffer)
+	{
+		const auto& pos = pi->GetPosition();
+
+		// Get unique neighboring cell coordinates in each 
+		// dimension. Small periodic grids would otherwise 
+		// visit the same cell more than once.
+		int cells[3][3], ncells[3];
+		for(int d = 0; d < 3; ++d)
+		{
+			int c = GetCellCoordinate(pos[d], d);
+			ncells[d] = 0;
+			for(int k = -1; k <= 1; ++k)
+			{
+				int ck = c + k;
+				if(IsPeriodic(d))
+					ck = (ck + _ncells[d]) % _ncells[d];
+				else if(ck < 0 || ck >= _ncells[d])
+					continue;
+
+				if(std::find(cells[d], cells[d] + ncells[d], ck) == cells[d] + ncells[d])
+					cells[d][ncells[d]++] = ck;
+			}
+		}
+
+		for(int a = 0; a < ncells[0]; ++a)
+			for(int b = 0; b < ncells[1]; ++b)
+				for(int c = 0; c < ncells[2]; ++c)
+				{
+					int cell = cells[0][a] + _ncells[0]*(cells[1][b] + _ncells[1]*cells[2][c]);
+					for(auto* pj : _cells[cell])
+					{
+						if(pi == pj)
+							continue;
+
+						// Only add inter (non same molecule).
+						if(pi->HasParent() && pj->HasParent() && 
+						  (pi->GetParent() == pj->GetParent()))
+							continue;
+
+						Position rij = pos - pj->GetPosition();
+						ApplyMinimumImage(&rij);
+
+						if(fdot(rij,rij) <= _ncutsq)
+						{
+							if(buffer != nullptr)
+								buffer->push_back(pj->GetPrimitiveIndex());
+							else
+								pi->AddNeighbor(pj);
+						}
+					}
+				}
+	}
+
 	void World::UpdateNeighborList()
 	{
 		auto& sim = SimInfo::Instance();
-		sim.StartTimer("nlist");
+		ProfileScope scope(ProfileNlist);
 
 		int n = this->GetPrimitiveCount();
 
+		// Full skin is available again.
+		_nlistradius = _ncut;
+		_skinsq = _skin*_skin;
+		_nlistsaved = false;
+
 		// Clear neighbor list before repopulating.
 		// We need to do this for parent particles
 		// (it propogates to children) because parent 
@@ -147,21 +409,139 @@ namespace SAPHRON
 			_particles[i]->SetCheckpoint();
 		}
 		
-		#pragma omp parallel
-		#pragma omp single
-		triangle(0, n);
+		// Periodically restore spatial locality of primitives. Deferred 
+		// rebuilds are not counted so the next one reorders instead.
+		bool reorder = _sortfreq > 0 && !_sortdeferred && (++_nrebuilds % _sortfreq) == 0;
+		if(reorder)
+			SortPrimitives();
+
+		// Neighbors are gathered in per-thread buffers, counted, 
+		// then copied into the arena.
+		if((int)_nbrbuf.size() < GetMaxThreads())
+			_nbrbuf.resize(GetMaxThreads());
+		for(auto& buffer : _nbrbuf)
+			buffer.clear();
+
+		_nbrcounts.assign(n, 0);
+		if(_nlistmode == CellList)
+		{
+			BuildCells();
+
+			// Each primitive's neighbors are contiguous in 
+			// the buffer of the thread that found them.
+			_nbrstart.resize(n);
+			_nbrowner.resize(n);
+			#pragma omp parallel
+			{
+				int tid = GetThreadNumber();
+				auto& buffer = _nbrbuf[tid];
+
+				#pragma omp for schedule(static)
+				for(int i = 0; i < n; ++i)
+				{
+					_nbrstart[i] = buffer.size();
+					AddCellNeighbors(_primitives[i], &buffer);
+					_nbrcounts[i] = buffer.size() - _nbrstart[i];
+					_nbrowner[i] = tid;
+				}
+			}
+
+			_arena.Allocate(_nbrcounts);
+
+			#pragma omp parallel for schedule(static)
+			for(int i = 0; i < n; ++i)
+			{
+				auto first = _nbrbuf[_nbrowner[i]].begin() + _nbrstart[i];
+				_arena.Assign(i, first, first + _nbrcounts[i]);
+			}
+		}
+		else
+		{
+			#pragma omp parallel
+			#pragma omp single
+			triangle(0, n);
+
+			// Buffers hold pairs.
+			for(auto& buffer : _nbrbuf)
+				for(auto& i : buffer)
+					++_nbrcounts[i];
+
+			_arena.Allocate(_nbrcounts);
+
+			for(auto& buffer : _nbrbuf)
+				for(size_t k = 0; k < buffer.size(); k += 2)
+					_arena.Link(buffer[k], buffer[k+1]);
+		}
+
+		// Order neighbors to follow primitive storage. Cell lists are 
+		// gathered one sided so their mirrored entries are linked here.
+		if(reorder || _nlistmode == CellList)
+			_arena.Pair();
+		if(reorder)
+			sim.IncrementCounter("nlist_sort");
+
+		// Pairs may have been missing from the old lists.
+		if(_estamps)
+			TouchAllEnergyStamps();
+	}
 
-		sim.AddTime("nlist");
+	void World::TuneSkinThickness()
+	{
+		if(!_skintune || _ncut <= 0 || ++_tuneiter < _tunewindow)
+			return;
+		_tuneiter = 0;
+
+		// Time spent on neighbor lists and interactions so far (us). 
+		// Without the profiler, wall time is used instead.
+		auto& prof = Profiler::Instance();
+		#ifdef SAPHRON_PROFILE
+		long time = (long)(1e6*(prof.GetTotal(ProfileNlist) + prof.GetTotal(ProfileInter)));
+		#else
+		long time = (long)(1e6*prof.GetElapsed());
+		#endif
+
+		// First window only establishes a baseline.
+		if(_tunetime < 0)
+		{
+			_tunetime = time;
+			return;
+		}
+
+		auto cost = time - _tunetime;
+		_tunetime = time;
+
+		// Turn around and refine if the last step did not pay off. 
+		// Keep a minimum step so the skin can follow changes in 
+		// density and move sizes.
+		if(_tunecost >= 0 && cost > _tunecost)
+			_tunestep *= -0.5;
+		if(std::abs(_tunestep) < 0.02)
+			_tunestep = std::copysign(0.02, _tunestep);
+		_tunecost = cost;
+
+		// Interaction cutoff is held fixed. Skin is bounded below by 
+		// a fraction of the cutoff and above by the minimum image.
+		auto rcut = _ncut - _skin;
+		auto lmin = std::min(_H(0,0), std::min(_H(1,1), _H(2,2)));
+		auto smin = 0.05*rcut;
+		auto smax = std::max(smin, std::min(rcut, 0.5*lmin - rcut));
+		auto skin = std::max(_skin, smin)*(1.0 + _tunestep);
+		skin = std::min(std::max(skin, smin), smax);
+
+		if(skin == _skin)
+			return;
+
+		SetSkinThickness(skin);
+		SetNeighborRadius(rcut + skin);
+		UpdateNeighborList();
 	}
 
 	void World::UpdateNeighborList(Particle* particle)
 	{
-		auto& sim = SimInfo::Instance();
-		sim.StartTimer("nlist");
+		ProfileScope scope(ProfileNlist);
 
+		_nlistsaved = false;
 		UpdateNeighborList(particle, true);
-		
-		sim.AddTime("nlist");
 	}
 
 	// Internal method. Allows for efficiency of clearing neighbor lists 
@@ -176,8 +556,16 @@ namespace SAPHRON
 			particle->SetCheckpoint();
 		}
 
-		// If particle has no child update it.
-		if(!particle->HasChildren())
+		// Use cell grid if available.
+		if(_nlistmode == CellList)
+		{
+			if(!_cellsvalid)
+				BuildCells();
+
+			if(!particle->HasChildren())
+				AddCellNeighbors(particle, nullptr);
+		}
+		else if(!particle->HasChildren()) // If particle has no child update it.
 		{
 			const auto& pos = particle->GetPosition();
 			for(size_t i = 0; i < _primitives.size(); ++i)
@@ -199,10 +587,7 @@ namespace SAPHRON
 				ApplyMinimumImage(&rij);
 
 				if(arma::dot(rij,rij) <= _ncutsq)
-				{
-					pi->AddNeighbor(particle);
 					particle->AddNeighbor(pi);
-				}
 			}
 		}
 		
@@ -242,7 +627,8 @@ namespace SAPHRON
 		for(int i = 0; i < nspecies-1; i++)
 			counts[nspecies-1] -= counts[i];
 
-		// New volume.
+		// New volume. The cell grid no longer matches the box.
+		InvalidateCells();
 		double vn = (double)n/density;
 		_H *= std::cbrt(vn/GetVolume());
 
@@ -354,38 +740,114 @@ namespace SAPHRON
 		UpdateNeighborList();
 	}
 
-	void World::SetVolume(double v, bool scale)
+	// Assigns new energy stamps to a particle and all of its descendants.
+	inline static void TouchDescendants(Particle* p)
 	{
-		auto l = pow(v, 1.0/3.0);
+		p->TouchEnergyStamp();
+		for(auto* child : p->GetChildren())
+			TouchDescendants(child);
+	}
 
-		if(scale)
+	void World::TouchEnergyStamps(Particle* p)
+	{
+		// Pairs missing from a stale neighbor list may have changed.
+		auto dist = p->GetCheckpointDist();
+		ApplyMinimumImage(&dist);
+		if(fdot(dist,dist) > _skinsq/4.0)
 		{
-			auto xs = l/_H(0,0);
-			auto ys = l/_H(1,1);
-			auto zs = l/_H(2,2);
+			TouchAllEnergyStamps();
+			return;
+		}
 
-			_H(0,0) = l;
-			_H(1,1) = l;
-			_H(2,2) = l;
+		// Intramolecular energies of the whole molecule, from the 
+		// outermost ancestor down.
+		auto* root = p;
+		while(root->HasParent())
+			root = root->GetParent();
+		TouchDescendants(root);
+
+		// Neighbors and every molecule containing them.
+		for(auto* neighbor : p->GetNeighbors())
+			for(auto* q = neighbor; q != nullptr; q = q->GetParent())
+				q->TouchEnergyStamp();
+	}
+
+	void World::TouchAllEnergyStamps()
+	{
+		for(auto& p : _particles)
+			p->TouchEnergyStamp();
+		for(auto& p : _primitives)
+			p->TouchEnergyStamp();
+	}
+
+	void World::ScaleParticles(double l)
+	{
+		auto xs = l/_H(0,0);
+		auto ys = l/_H(1,1);
+		auto zs = l/_H(2,2);
 
+		// Bring checkpoints to the periodic image nearest their particle
+		// so shifting both by the same amount preserves displacements.
+		for(auto* plist : {&_particles, &_primitives})
+		{
 			#pragma omp parallel for schedule(static)
-			for(auto it = _particles.begin(); it < _particles.end(); ++it)
+			for(auto it = plist->begin(); it < plist->end(); ++it)
 			{
-				auto pos = (*it)->GetPosition();
-				pos[0] *= xs;
-				pos[1] *= ys;
-				pos[2] *= zs;
-				ApplyPeriodicBoundaries(&pos);
-				(*it)->SetPosition(pos);
+				auto d = (*it)->GetCheckpointDist();
+				ApplyMinimumImage(&d);
+				(*it)->SetCheckpoint((*it)->GetPosition() - d);
 			}
+		}
+
+		_H(0,0) = l;
+		_H(1,1) = l;
+		_H(2,2) = l;
+
+		// Particle events are handled in parallel below, so energy 
+		// stamps are assigned afterwards and charge changes are not 
+		// logged (consumers rebuild on box changes).
+		bool estamps = _estamps, qtrack = _qtrack;
+		_estamps = false;
+		_qtrack = false;
 
+		#pragma omp parallel for schedule(static)
+		for(auto it = _particles.begin(); it < _particles.end(); ++it)
+		{
+			auto pos = (*it)->GetPosition();
+			Position d{pos[0]*(xs - 1.), pos[1]*(ys - 1.), pos[2]*(zs - 1.)};
+			pos += d;
+			ApplyPeriodicBoundaries(&pos);
+			(*it)->SetPosition(pos);
+			(*it)->TranslateCheckpoint(d);
 		}
-		else
+
+		_estamps = estamps;
+		if(_estamps)
+			TouchAllEnergyStamps();
+
+		_qtrack = qtrack;
+		DropChargeLog();
+	}
+
+	void World::SetVolume(double v, bool scale)
+	{
+		auto l = pow(v, 1.0/3.0);
+
+		// Cell grid is rebuilt when next needed. This also keeps 
+		// the (parallel) position updates from touching it.
+		InvalidateCells();
+
+		if(!scale)
 		{
 			_H(0,0) = l;
 			_H(1,1) = l;
 			_H(2,2) = l;
 
+			// Stamps are assigned by the neighbor list update.
+			bool estamps = _estamps, qtrack = _qtrack;
+			_estamps = false;
+			_qtrack = false;
+
 			#pragma omp parallel for schedule(static)
 			for(auto it = _particles.begin(); it < _particles.end(); ++it)
 			{
@@ -393,10 +855,112 @@ namespace SAPHRON
 				ApplyPeriodicBoundaries(&pos);
 				(*it)->SetPosition(pos);
 			}
+
+			_estamps = estamps;
+			_qtrack = qtrack;
+			DropChargeLog();
+
+			// Regenerate neighbor list.
+			UpdateNeighborList();
+			return;
 		}
-		
-		// Regenerate neighbor list.
-		UpdateNeighborList();
+
+		auto xs = l/_H(0,0);
+		auto ys = l/_H(1,1);
+		auto zs = l/_H(2,2);
+
+		// Largest checkpoint displacement and child offset of primitives.
+		double dmax = 0, rmax = 0;
+		for(auto& p : _primitives)
+		{
+			auto d = p->GetCheckpointDist();
+			ApplyMinimumImage(&d);
+			dmax = std::max(dmax, fdot(d, d));
+			if(p->HasParent())
+			{
+				Position r = p->GetPosition() - p->GetParent()->GetPosition();
+				ApplyMinimumImage(&r);
+				rmax = std::max(rmax, fdot(r, r));
+			}
+		}
+		dmax = sqrt(dmax);
+		rmax = sqrt(rmax);
+
+		// Save state for RestoreVolume.
+		_radiusstash = _nlistradius;
+		_skinsqstash = _skinsq;
+		_nlistrebuilt = false;
+
+		// Centers of mass are scaled, so the separation of primitives in 
+		// different particles changes by at most the scaled separation of 
+		// their centers, which is bounded using checkpoint displacements 
+		// and child offsets. Checkpoints move with their particles so 
+		// displacements are unchanged. Growth is capped at the neighbor 
+		// radius which bounds pairs from single particle updates.
+		auto smin = std::min(xs, std::min(ys, zs));
+		auto dsmax = std::max(std::abs(xs - 1.), std::max(std::abs(ys - 1.), std::abs(zs - 1.)));
+		auto radius = std::min(_ncut, smin*_nlistradius - 2.*dsmax*(dmax + rmax));
+		auto skin = radius - (_ncut - _skin);
+		bool valid = skin > 2.*dmax;
+
+		// Stash list and checkpoints before a rebuild.
+		if(!valid)
+		{
+			_nlistrebuilt = true;
+			_arenastash.Swap(_arena);
+			_arena.Reset(_primitives.size());
+			_checkstash.resize(_particles.size() + _primitives.size());
+			for(size_t i = 0; i < _particles.size(); ++i)
+				_checkstash[i] = _particles[i]->GetCheckpoint();
+			for(size_t i = 0; i < _primitives.size(); ++i)
+				_checkstash[_particles.size() + i] = _primitives[i]->GetCheckpoint();
+		}
+
+		ScaleParticles(l);
+
+		if(valid)
+		{
+			_nlistradius = radius;
+			_skinsq = skin*skin;
+			SimInfo::Instance().IncrementCounter("nlist_reuse");
+		}
+		else
+		{
+			// Stashed lists and checkpoints refer to primitives by index.
+			_sortdeferred = true;
+			UpdateNeighborList();
+			_sortdeferred = false;
+		}
+
+		_nlistsaved = true;
+	}
+
+	void World::RestoreVolume(double v)
+	{
+		if(!_nlistsaved)
+		{
+			SetVolume(v, true);
+			return;
+		}
+
+		InvalidateCells();
+
+		ScaleParticles(pow(v, 1.0/3.0));
+
+		// Swap back the list that preceded the rebuild.
+		if(_nlistrebuilt)
+		{
+			_arena.Swap(_arenastash);
+			for(size_t i = 0; i < _particles.size(); ++i)
+				_particles[i]->SetCheckpoint(_checkstash[i]);
+			for(size_t i = 0; i < _primitives.size(); ++i)
+				_primitives[i]->SetCheckpoint(_checkstash[_particles.size() + i]);
+		}
+
+		_nlistradius = _radiusstash;
+		_skinsq = _skinsqstash;
+		_nlistsaved = false;
+		SimInfo::Instance().IncrementCounter("nlist_reuse");
 	}
 
 	void World::Serialize(Json::Value& json) const
@@ -418,6 +982,10 @@ namespace SAPHRON
 		json["seed"] = this->GetSeed();
 		json["skin_thickness"] = this->GetSkinThickness();
 		json["nlist_cutoff"] = this->GetNeighborRadius();
+		json["nlist_method"] = (this->GetNeighborListMode() == CellList) ? "cell" : "allpairs";
+		json["sort_frequency"] = this->GetSortFrequency();
+		if(this->GetSkinTuning())
+			json["skin_tune"]["window"] = this->GetSkinTuningWindow();
 
 		// Serialize chemical potentials.
 		auto& slist = Particle::GetSpeciesList();
@@ -521,6 +1089,17 @@ namespace SAPHRON
 		world->SetPeriodicY(periody);
 		world->SetPeriodicZ(periodz);			
 
+		// Neighbor list method.
+		if(json.get("nlist_method", "allpairs").asString() == "cell")
+			world->SetNeighborListMode(CellList);
+
+		// Spatial reordering frequency.
+		world->SetSortFrequency(json.get("sort_frequency", 0).asInt());
+
+		// Automatic skin tuning.
+		if(json.isMember("skin_tune"))
+			world->SetSkinTuning(true, json["skin_tune"].get("window", 10).asInt());
+
 		// Initialize particles.
 		if(json.isMember("particles"))
 		{ 
@@ -11,6 +11,7 @@
 #include <memory>
 #include <functional>
 #include <armadillo>
+#include <array>
 #include <queue>
 
 namespace SAPHRON
@@ -19,7 +20,34 @@ namespace SAPHRON
 	typedef std::vector<World*> WorldList;
 	typedef std::vector<int> WorldIndexList;
 	typedef std::vector<std::queue<Particle*>> StashList;
+
+	// Neighbor list construction method.
+	enum NeighborListMode
+	{
+		AllPairs,
+		CellList
+	};
 	
+	// Structure-of-arrays storage of primitive properties. Entries 
+	// are index aligned with the world's primitive list so hot loops 
+	// can stream coordinates, directors, charges and species linearly.
+	struct PrimitiveArrays
+	{
+		std::vector<double> x, y, z;
+		std::vector<double> ux, uy, uz;
+		std::vector<double> q;
+		std::vector<int> species;
+	};
+
+	// Change in the charge or position of a primitive (see 
+	// World::TrackChargeChanges). Additions have no old charge 
+	// and removals no new charge.
+	struct ChargeChange
+	{
+		double qold, qnew;
+		Position rold, rnew;
+	};
+
 	// Public interface representing the "World" in which particles live. 
 	// A World object is responsible for setting up the "box" and associated 
 	// geometry, handling boundary conditions and updating negihbor lists on
@@ -42,9 +70,46 @@ namespace SAPHRON
 		// Periodic boundaries.
 		bool _periodx, _periody, _periodz;
 
-		// Skin thickness (calculated).
+		// Skin thickness (calculated). The squared value is the skin 
+		// that remains after volume scaling since the last rebuild.
 		double _skin, _skinsq;
 
+		// Guaranteed separation of primitive pairs missing from the 
+		// neighbor list, measured at their checkpoints. Equal to the 
+		// neighbor radius after a rebuild and reduced by volume scaling.
+		double _nlistradius;
+
+		// Neighbor list construction method.
+		NeighborListMode _nlistmode;
+
+		// Cell list data. Primitives are binned into cells of at 
+		// least the neighbor list cutoff in each direction. The grid 
+		// is kept current through particle position events so 
+		// single particle updates only need to visit adjacent cells.
+		std::array<int, 3> _ncells;
+		std::array<double, 3> _cellsize;
+		std::vector<ParticleList> _cells;
+
+		// Is the cell grid consistent with the box and particles?
+		bool _cellsvalid;
+
+		// Number of full neighbor list rebuilds between spatial 
+		// reordering of primitives (0 disables) and rebuild counter.
+		int _sortfreq, _nrebuilds;
+
+		// Is reordering deferred? Set while neighbor lists and checkpoints 
+		// are stashed by primitive index (see SetVolume).
+		bool _sortdeferred;
+
+		// Skin tuning data. The skin is adjusted every _tunewindow 
+		// iterations by a multiplicative step that is reversed and 
+		// halved whenever the measured neighbor list and energy 
+		// evaluation time of a window increases.
+		bool _skintune;
+		int _tunewindow, _tuneiter;
+		double _tunestep;
+		long _tunetime, _tunecost;
+
 		// System properties.
 		double _temperature; 
 
@@ -52,6 +117,19 @@ namespace SAPHRON
 
 		Pressure _pressure;
 
+		// Is the stored pressure up to date?
+		bool _pressurevalid;
+
+		// Are particle energy stamps tracked?
+		bool _estamps;
+
+		// Are charge changes logged? Consumers only hold a const world.
+		mutable bool _qtrack;
+
+		// Log of charge changes and sequence number of its first entry.
+		std::vector<ChargeChange> _qlog;
+		unsigned long _qlogbase;
+
 		// Chemical potential.
 		std::vector<double> _chemp;
 
@@ -66,6 +144,35 @@ namespace SAPHRON
 		// Primitive particle list.
 		ParticleList _primitives;
 
+		// Primitive property storage.
+		PrimitiveArrays _soa;
+
+		// Neighbor lists of primitives.
+		NeighborArena _arena;
+
+		// Neighbor list state saved by a scaling SetVolume so a 
+		// rejected volume move can be undone by RestoreVolume. Lists 
+		// and checkpoints are only saved if the list was rebuilt.
+		NeighborArena _arenastash;
+		std::vector<Position> _checkstash;
+		double _radiusstash, _skinsqstash;
+		bool _nlistsaved, _nlistrebuilt;
+
+		// Neighbor list assembly buffers (per thread) and 
+		// per primitive counts, buffer locations and owners.
+		std::vector<std::vector<uint32_t>> _nbrbuf;
+		std::vector<uint32_t> _nbrcounts;
+		std::vector<size_t> _nbrstart;
+		std::vector<int> _nbrowner;
+
+		// Particles and primitives grouped by species for 
+		// constant time species selection.
+		std::vector<ParticleList> _speciesparticles, _speciesprimitives;
+
+		// Location of each particle (primitive) in its species list. 
+		// Index aligned with the particle (primitive) list.
+		std::vector<int> _speciespos, _primspeciespos;
+
 		// Random number generator.
 		Rand _rand;
 
@@ -95,6 +202,86 @@ namespace SAPHRON
 		void RemoveParticleComposition(Particle* particle);
 		void ModifyParticleComposition(const ParticleEvent& pEvent);
 		void UpdateNeighborList(Particle* particle, bool clear);
+		void AddPrimitive(Particle* particle);
+		void RemovePrimitive(Particle* particle);
+
+		// Add particle stored at "index" to species list "id".
+		inline static void AddToSpeciesList(std::vector<ParticleList>& lists, 
+											std::vector<int>& pos, 
+											Particle* particle, int id, int index)
+		{
+			if((int)lists.size() - 1 < id)
+				lists.resize(id + 1);
+			pos[index] = (int)lists[id].size();
+			lists[id].push_back(particle);
+		}
+
+		// Remove particle stored at "index" from species list "id". The 
+		// last entry is moved into its place and located through "getindex".
+		inline static void RemoveFromSpeciesList(std::vector<ParticleList>& lists, 
+												 std::vector<int>& pos, 
+												 int (Particle::*getindex)() const,
+												 int id, int index)
+		{
+			auto& list = lists[id];
+			int j = pos[index];
+			list[j] = list.back();
+			pos[(list[j]->*getindex)()] = j;
+			list.pop_back();
+			pos[index] = -1;
+		}
+
+		// Is particle a top level particle in this world?
+		inline bool IsStoredParticle(const Particle* p) const
+		{
+			int i = p->GetWorldIndex();
+			return i >= 0 && i < (int)_particles.size() && _particles[i] == p;
+		}
+
+		// Copy primitive properties into structure-of-arrays storage.
+		inline void SyncPrimitive(const Particle* p)
+		{
+			int i = p->GetPrimitiveIndex();
+			const auto& pos = p->GetPosition();
+			const auto& dir = p->GetDirector();
+			_soa.x[i] = pos[0];
+			_soa.y[i] = pos[1];
+			_soa.z[i] = pos[2];
+			_soa.ux[i] = dir[0];
+			_soa.uy[i] = dir[1];
+			_soa.uz[i] = dir[2];
+			_soa.q[i] = p->GetCharge();
+			_soa.species[i] = p->GetSpeciesID();
+		}
+
+		// Logs a charge change if tracked. The log is dropped once it 
+		// outgrows the primitives since replaying it would cost more 
+		// than a rebuild.
+		inline void LogChargeChange(double qold, const Position& rold, 
+		                            double qnew, const Position& rnew)
+		{
+			if(!_qtrack || (qold == 0 && qnew == 0))
+				return;
+
+			if(_qlog.size() >= std::max(_primitives.size(), (size_t)64))
+				DropChargeLog();
+			_qlog.push_back(ChargeChange{qold, qnew, rold, rnew});
+		}
+
+		// Drops logged charge changes. Consumers must rebuild.
+		inline void DropChargeLog()
+		{
+			_qlogbase += _qlog.size() + 1;
+			_qlog.clear();
+		}
+
+		// Is particle a primitive stored in this world? Clones copy 
+		// the observer list so the index must be checked.
+		inline bool IsStoredPrimitive(const Particle* p) const
+		{
+			int i = p->GetPrimitiveIndex();
+			return i >= 0 && i < (int)_primitives.size() && _primitives[i] == p;
+		}
 
 		// Compute de Broglie wavelength for particle p.
 		void ComputeWavelength(Particle* p)
@@ -135,13 +322,74 @@ namespace SAPHRON
 			// and create new for particle and children.
 			if(updatelist)
 				this->UpdateNeighborList(particle);
+
+			if(_estamps)
+			{
+				TouchEnergyStamps(particle);
+				for(auto& child : *particle)
+					TouchEnergyStamps(child);
+			}
 		}
 
+		// Assigns new energy stamps to particle p and the particles whose 
+		// energy depends on it: parents, siblings and neighbors.
+		void TouchEnergyStamps(Particle* p);
+
+		// Assigns new energy stamps to all particles.
+		void TouchAllEnergyStamps();
+
 		// Methods for parallel neighbor list.
 		void rect(int i0, int i1, int j0, int j1);
 		void triangle(int n0, int n1);
 		void AddNeighbor(Particle* pi, Particle*pj);
 
+		// Reorder primitives along a Morton (Z-order) curve.
+		void SortPrimitives();
+
+		// Methods for cell list neighbor list.
+		void BuildCells();
+		void AddCellNeighbors(Particle* pi, std::vector<uint32_t>* buffer);
+		void AddToCell(Particle* particle);
+		bool RemoveFromCell(Particle* particle, const Position& pos);
+
+		// Invalidates the cell grid. It is rebuilt on the next 
+		// neighbor list update.
+		inline void InvalidateCells() { _cellsvalid = false; }
+
+		// Scales the box to a cube of edge l and particle positions with 
+		// it. Checkpoints follow their particles.
+		void ScaleParticles(double l);
+
+		// Get the cell coordinate of position x along dimension d.
+		inline int GetCellCoordinate(double x, int d) const
+		{
+			int c = ffloor(x/_cellsize[d]);
+			if(IsPeriodic(d))
+				return ((c % _ncells[d]) + _ncells[d]) % _ncells[d];
+			
+			return std::min(std::max(c, 0), _ncells[d] - 1);
+		}
+
+		// Get the (linear) cell index of coordinates x, y, z.
+		inline int GetCellIndex(double x, double y, double z) const
+		{
+			return GetCellCoordinate(x, 0) + 
+			_ncells[0]*(GetCellCoordinate(y, 1) + 
+			_ncells[1]*GetCellCoordinate(z, 2));
+		}
+
+		// Get the (linear) cell index of a position.
+		inline int GetCellIndex(const Position& pos) const
+		{
+			return GetCellIndex(pos[0], pos[1], pos[2]);
+		}
+
+		// Is dimension d periodic?
+		inline bool IsPeriodic(int d) const
+		{
+			return (d == 0) ? _periodx : ((d == 1) ? _periody : _periodz);
+		}
+
 
 	protected:
 
@@ -156,8 +404,15 @@ namespace SAPHRON
 		World(double xl, double yl, double zl, double ncut, double skin, unsigned seed = 1) : 
 		_ncut(ncut), _ncutsq(ncut*ncut), _H(arma::fill::zeros), _diag(true),
 		_periodx(true), _periody(true), _periodz(true), _skin(skin), _skinsq(skin*skin), 
-		_temperature(0.0), _chemp(0), _debroglie(0), _nbrs(0), _particles(0), _primitives(0), 
-		_rand(seed), _composition(0), _stash(0), _seed(seed), _id(_nextID++)
+		_nlistradius(ncut), 
+		_nlistmode(AllPairs), _ncells(), _cellsize(), _cells(0), _cellsvalid(false),
+		_sortfreq(0), _nrebuilds(0), _sortdeferred(false), _skintune(false), _tunewindow(10), _tuneiter(0), 
+		_tunestep(0.2), _tunetime(-1), _tunecost(-1), 
+		_temperature(0.0), _pressurevalid(true), _estamps(false), _qtrack(false), _qlog(), _qlogbase(0), _chemp(0), _debroglie(0), _nbrs(0), _particles(0), _primitives(0), 
+		_soa(), _arena(&_primitives), _arenastash(&_primitives), _checkstash(0), 
+		_radiusstash(ncut), _skinsqstash(skin*skin), _nlistsaved(false), _nlistrebuilt(false), _nbrbuf(0), _nbrcounts(0), _nbrstart(0), 
+		_nbrowner(0), _speciesparticles(0), _speciesprimitives(0), 
+		_speciespos(0), _primspeciespos(0), _rand(seed), _composition(0), _stash(0), _seed(seed), _id(_nextID++)
 		{
 			_stringid = "world" + std::to_string(_id);
 			_H(0,0) = xl;
@@ -211,11 +466,12 @@ namespace SAPHRON
 		// Will return nullptr if species doesn't exist.
 		Particle* DrawRandomParticleBySpecies(int species)
 		{
-			if((int)_composition.size() - 1 < species || _composition[species] < 1)
+			int n = GetParticleCountBySpecies(species);
+			if(n < 1)
 				return nullptr; 
 
 			// Select random number betwene [0, count-1].
-			int i = _rand.int32() % _composition[species];
+			int i = _rand.int32() % n;
 			return SelectParticleBySpecies(species, i);
 		}
 
@@ -260,10 +516,11 @@ namespace SAPHRON
 		// Will return nullptr if species don't exist.
 		Particle* DrawRandomPrimitiveBySpecies(int species)
 		{
-			if((int)_composition.size() - 1 < species || _composition[species] < 1)
+			int n = GetPrimitiveCountBySpecies(species);
+			if(n < 1)
 				return nullptr;
 
-			int i = _rand.int32() % _composition[species];
+			int i = _rand.int32() % n;
 			return SelectPrimitiveBySpecies(species, i);
 		}
 
@@ -308,6 +565,47 @@ namespace SAPHRON
 				UpdateNeighborList();
 		}
 
+		// Would neighbor lists remain valid if particle p 
+		// (and its children) were displaced by dr?
+		bool IsNeighborListValid(const Particle* p, const Position& dr) const
+		{
+			Position dist = p->GetCheckpointDist() + dr;
+			ApplyMinimumImage(&dist);
+			return fdot(dist,dist) <= _skinsq/4.0;
+		}
+
+		// Tracks particle energy stamps (see Particle::GetEnergyStamp) so 
+		// that cached particle energies can be validated in constant time. 
+		// Stamps change on particle events, additions, removals, neighbor 
+		// list rebuilds and volume changes.
+		void TrackEnergyStamps()
+		{
+			if(_estamps)
+				return;
+
+			_estamps = true;
+			TouchAllEnergyStamps();
+		}
+
+		// Are particle energy stamps tracked?
+		bool IsTrackingEnergyStamps() const { return _estamps; }
+
+		// Logs changes in the charge or position of charged primitives, 
+		// including additions and removals, so that long range 
+		// electrostatics can be updated incrementally.
+		void TrackChargeChanges() const { _qtrack = true; }
+
+		// Are charge changes logged?
+		bool IsTrackingChargeChanges() const { return _qtrack; }
+
+		// Gets logged charge changes. Entry k has sequence number 
+		// GetChargeLogStart() + k. A consumer that has not seen changes 
+		// before the start must rebuild from the primitive arrays.
+		const std::vector<ChargeChange>& GetChargeLog() const { return _qlog; }
+
+		// Gets the sequence number of the first logged charge change.
+		unsigned long GetChargeLogStart() const { return _qlogbase; }
+
 		// Get a specific particle based on location.
 		Particle* SelectParticle(int location)
 		{
@@ -323,49 +621,41 @@ namespace SAPHRON
 		// Select the "ith" particle of species "species". 
 		Particle* SelectParticleBySpecies(int species, int i)
 		{
-			auto it = std::find_if(_particles.begin(), _particles.end(),[=](Particle* p){
-				return p->GetSpeciesID() == species;
-			});
-
-			while(--i >= 0 && it != _particles.end())
-			{
-				++it;
-    			it =  std::find_if(it, _particles.end(),[=](Particle* p){
-					return p->GetSpeciesID() == species;
-				});
-			}
-
-			return *it;
+			return _speciesparticles[species][i];
 		}
 
 		// Select the "ith" particle of species "species" (const). 
 		const Particle* SelectParticleBySpecies(int species, int i) const
 		{
-			return SelectParticleBySpecies(species, i);
+			return _speciesparticles[species][i];
 		}
 
 		// Select the "ith" primitive of species "species".
 		Particle* SelectPrimitiveBySpecies(int species, int i)
 		{
-			auto it = std::find_if(_primitives.begin(), _primitives.end(), [=](Particle* p){
-				return p->GetSpeciesID() == species;
-			});
-
-			while(--i >= 0 && it != _primitives.end())
-			{
-				++it;
-				it = std::find_if(it, _primitives.end(), [=](Particle* p){
-					return p->GetSpeciesID() == species;
-				});
-			}
-
-			return *it;
+			return _speciesprimitives[species][i];
 		}
 
 		// Select the "ith" primitive of species "species" (const).
 		const Particle* SelectPrimitiveBySpecies(int species, int i) const
 		{
-			return SelectPrimitiveBySpecies(species, i);
+			return _speciesprimitives[species][i];
+		}
+
+		// Get the number of (top level) particles of species "species".
+		int GetParticleCountBySpecies(int species) const
+		{
+			if((int)_speciesparticles.size() - 1 < species)
+				return 0;
+			return (int)_speciesparticles[species].size();
+		}
+
+		// Get the number of primitives of species "species".
+		int GetPrimitiveCountBySpecies(int species) const
+		{
+			if((int)_speciesprimitives.size() - 1 < species)
+				return 0;
+			return (int)_speciesprimitives[species].size();
 		}
 
 		// Select a primitive particle by location.
@@ -379,20 +669,25 @@ namespace SAPHRON
 		{
 			return _primitives[location];
 		}
+
+		// Get structure-of-arrays primitive storage. Indices correspond 
+		// to primitive locations and Particle::GetPrimitiveIndex.
+		const PrimitiveArrays& GetPrimitiveArrays() const { return _soa; }
 		
 		// Add a particle. Option to update neighbor list or not.
 		void AddParticle(Particle&& particle, bool updatelist = true)
 		{
-			_particles.push_back(std::move(&particle));
-			// Do this after since we are moving.
-			ConfigureParticle(_particles.back(), updatelist); 
+			AddParticle(&particle, updatelist);
 		}
 
 		// Add a particle.
 		void AddParticle(Particle* particle, bool updatelist = true)
 		{
-			ConfigureParticle(particle, updatelist);
+			// Store first so configuration can index it.
+			particle->SetWorldIndex((int)_particles.size());
 			_particles.push_back(particle);
+			_speciespos.push_back(-1);
+			ConfigureParticle(particle, updatelist);
 		}
 
 		// Remove a specific particle based on location.
@@ -402,21 +697,39 @@ namespace SAPHRON
 			RemoveParticle(p);
 		}
 
-		// Remove particle based on pointer.
+		// Remove particle based on pointer. The last particle 
+		// is moved into the vacated location.
 		void RemoveParticle(Particle* particle) 
 		{
-			auto it = std::find(_particles.begin(), _particles.end(), particle);
-			if(it != _particles.end())
+			if(!IsStoredParticle(particle))
+				return;
+
+			if(_estamps)
 			{
-				particle->RemoveFromNeighbors();
-				particle->ClearNeighborList();
+				TouchEnergyStamps(particle);
+				for(auto& child : *particle)
+					TouchEnergyStamps(child);
+			}
 
-				particle->RemoveObserver(this);
-				particle->SetWorld(nullptr);
-				RemoveParticleComposition(particle);
+			particle->RemoveFromNeighbors();
+			particle->ClearNeighborList();
+
+			particle->RemoveObserver(this);
+			particle->SetWorld(nullptr);
+			RemoveParticleComposition(particle);
 
-				_particles.erase(it);
+			int i = particle->GetWorldIndex();
+			int last = (int)_particles.size() - 1;
+			if(i != last)
+			{
+				_particles[i] = _particles[last];
+				_particles[i]->SetWorldIndex(i);
+				_speciespos[i] = _speciespos[last];
 			}
+
+			_particles.pop_back();
+			_speciespos.pop_back();
+			particle->SetWorldIndex(-1);
 		}
 
 		// Stash particle itself. Make sure 
@@ -557,8 +870,52 @@ namespace SAPHRON
 		{
 			_ncutsq = ncut*ncut;
 			_ncut = ncut;
+			InvalidateCells();
+		}
+
+		// Get the neighbor list construction method.
+		NeighborListMode GetNeighborListMode() const { return _nlistmode; }
+
+		// Set the neighbor list construction method. Cell lists scale 
+		// linearly with the number of primitives, all pairs quadratically.
+		void SetNeighborListMode(NeighborListMode mode) 
+		{ 
+			_nlistmode = mode; 
+			InvalidateCells();
 		}
 
+		// Get the number of full neighbor list rebuilds between 
+		// spatial reordering of primitives.
+		int GetSortFrequency() const { return _sortfreq; }
+
+		// Set the number of full neighbor list rebuilds between 
+		// spatial reordering of primitives. Zero disables reordering.
+		void SetSortFrequency(int freq) { _sortfreq = freq; }
+
+		// Is automatic skin tuning enabled?
+		bool GetSkinTuning() const { return _skintune; }
+
+		// Get the number of iterations between skin adjustments.
+		int GetSkinTuningWindow() const { return _tunewindow; }
+
+		// Enable or disable automatic skin tuning. The skin is adjusted
+		// every "window" iterations to minimize the time spent building
+		// neighbor lists and evaluating interaction energies.
+		void SetSkinTuning(bool tune, int window = 10)
+		{
+			_skintune = tune;
+			_tunewindow = std::max(window, 1);
+			_tuneiter = 0;
+			_tunestep = 0.2;
+			_tunetime = -1;
+			_tunecost = -1;
+		}
+
+		// Adjust skin thickness based on the measured cost of the last 
+		// tuning window. The interaction cutoff (neighbor radius less 
+		// skin) is kept constant. Should be called once per iteration.
+		void TuneSkinThickness();
+
 		// Get the effective skin thickness of the world.
 		double GetSkinThickness() const { return _skin;	}
 
@@ -617,11 +974,23 @@ namespace SAPHRON
 		}
 		
 		// Set world pressure. 
-		void SetPressure(const Pressure& p) { _pressure = p; }
+		void SetPressure(const Pressure& p) 
+		{ 
+			_pressure = p; 
+			_pressurevalid = true;
+		}
 
 		// Increment world pressure. (aka p += dp).
 		void IncrementPressure(const Pressure& dp) { _pressure += dp; }
 
+		// Marks the stored pressure as out of date. Used by moves which 
+		// only evaluate energies. The simulation recomputes it before it 
+		// is observed.
+		void InvalidatePressure() { _pressurevalid = false; }
+
+		// Is the stored pressure up to date?
+		bool IsPressureValid() const { return _pressurevalid; }
+
 		// Get world energy. 
 		Energy GetEnergy() const { return _energy; }
 
@@ -711,20 +1080,40 @@ namespace SAPHRON
 		// scale the coordinates of the particles in the system. 
 		// Energy recalculation after this procedure is recommended.
 		// If scaling is not applied, periodic boundary conditions 
-		// are applied to all particles. The neighbor list is auto regenerated.
+		// are applied to all particles. When scaling, the neighbor list is 
+		// kept if the remaining skin covers the scaled displacements, 
+		// otherwise it is regenerated.
 		void SetVolume(double v, bool scale);
 
+		// Scales the world back to volume v after SetVolume(vn, true), 
+		// restoring the neighbor list that preceded it rather than 
+		// rebuilding. Falls back to SetVolume(v, true) if the world 
+		// has changed since.
+		void RestoreVolume(double v);
+
 		// Gets/sets the periodicity of the x-coordinate.
 		bool GetPeriodicX() const { return _periodx; }
-		void SetPeriodicX(bool periodic) { _periodx = periodic; }
+		void SetPeriodicX(bool periodic) 
+		{ 
+			_periodx = periodic; 
+			InvalidateCells();
+		}
 
 		// Gets/sets the periodicity of the y-coordinate.
 		bool GetPeriodicY() const { return _periody; }
-		void SetPeriodicY(bool periodic) { _periody = periodic; }
+		void SetPeriodicY(bool periodic) 
+		{ 
+			_periody = periodic; 
+			InvalidateCells();
+		}
 
 		// Gets/sets the periodicity of the z-coordinate.
 		bool GetPeriodicZ() const { return _periodz; }
-		void SetPeriodicZ(bool periodic) { _periodz = periodic; }
+		void SetPeriodicZ(bool periodic) 
+		{ 
+			_periodz = periodic; 
+			InvalidateCells();
+		}
 
 		// Iterators.
 		iterator begin() { return _particles.begin(); }
@@ -738,9 +1127,47 @@ namespace SAPHRON
 		 *                                 *
 		 ***********************************/
 
-		// Particle observer to update world composition.
+		// Particle observer to update world composition, primitive 
+		// storage and cell grid.
 		virtual void ParticleUpdate(const ParticleEvent& pEvent) override
 		{
+			auto* p = pEvent.GetParticle();
+			if(IsStoredPrimitive(p))
+			{
+				int i = p->GetPrimitiveIndex();
+				if(pEvent.position)
+				{
+					const auto& pos = p->GetPosition();
+					_soa.x[i] = pos[0];
+					_soa.y[i] = pos[1];
+					_soa.z[i] = pos[2];
+				}
+
+				if(pEvent.director)
+				{
+					const auto& dir = p->GetDirector();
+					_soa.ux[i] = dir[0];
+					_soa.uy[i] = dir[1];
+					_soa.uz[i] = dir[2];
+				}
+
+				if(pEvent.charge)
+					_soa.q[i] = p->GetCharge();
+
+				if(pEvent.species)
+					_soa.species[i] = p->GetSpeciesID();
+
+				if(_qtrack && (pEvent.position || pEvent.charge))
+					LogChargeChange(pEvent.charge ? pEvent.GetOldCharge() : p->GetCharge(), 
+					                pEvent.position ? pEvent.GetOldPosition() : p->GetPosition(), 
+					                p->GetCharge(), p->GetPosition());
+
+				// Only move particles that are actually binned.
+				if(pEvent.position && _cellsvalid && 
+				   RemoveFromCell(p, pEvent.GetOldPosition()))
+					AddToCell(p);
+			}
+
 			if(pEvent.species)
 				ModifyParticleComposition(pEvent);
 
@@ -749,6 +1176,9 @@ namespace SAPHRON
 	
 			if(pEvent.child_remove)
 				RemoveParticleComposition(pEvent.GetChild());
+
+			if(_estamps && pEvent.mask)
+				TouchEnergyStamps(p);
 		}
 
 		// Accept a visitor.
@@ -4,6 +4,7 @@
 #include <iomanip>
 
 #include "Simulation/SimBuilder.h"
+#include "Utils/Profiler.h"
 #include "config.h"
 
 using namespace SAPHRON;
@@ -77,6 +78,9 @@ int main(int argc, char* argv[])
 	
 		try{
 			auto* sim = builder.GetSimulation();
+
+			// Only time the run itself.
+			Profiler::Instance().Reset();
 			sim->Run();
 		}catch(std::exception& e){
 			#ifdef MULTI_WALKER
@@ -101,19 +105,20 @@ int main(int argc, char* argv[])
 		
 		// Time Info. 
 		auto& info = SimInfo::Instance();
-		info.AddTime("total");
+		auto& prof = Profiler::Instance();
 
-		auto& map = info.GetTimerMap();
-		auto tot = map.at("total").elapsed_time;
+		auto tot = prof.GetElapsed();
 		std::cout << " * Elapsed time breakdown during simulation:\n";
 		std::cout << std::fixed << std::setprecision(2);
-		for(auto& it : map)
-		{
-			auto t = it.second.elapsed_time;
+		std::cout << " * Total: " << tot << " s" << std::endl;
+		for(auto& e : prof.GetReport())
+			std::cout << " * " << std::string(2*e.depth, ' ') << info.ResolveTimerName(e.name) 
+					  << ": " << e.seconds << " s" 
+					  << " (" << e.seconds/tot*100. << "%)" << std::endl;
+
+		for(auto& it : info.GetCounterMap())
 			std::cout << " * " << info.ResolveTimerName(it.first) 
-					  << ": " << std::chrono::duration_cast<std::chrono::seconds>(t).count() << " s" 
-					  << " (" << (double)t.count()/(double)tot.count()*100. << "%)" << std::endl;
-		}
+					  << ": " << it.second << std::endl;
 		#ifdef MULTI_WALKER
 		}
 		#endif
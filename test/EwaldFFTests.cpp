@@ -7,10 +7,67 @@
 #include "../src/Simulation/SimException.h"
 #include "../src/Worlds/World.h"
 #include "../src/Worlds/WorldManager.h"
+#include "../src/Utils/Rand.h"
 #include "gtest/gtest.h"
 
 using namespace SAPHRON;
 
+// Loads the NIST SPC/E configuration. Nonbonded cutoffs are indexed by 
+// world ID so they are copied up to the ID of the loaded world.
+static World* LoadNIST(Json::Value& root)
+{
+	std::ifstream t("../test/nist_spce_ewald1.json");
+	std::stringstream buffer;
+	buffer << t.rdbuf();
+	Json::Reader reader;
+	if(!reader.parse(buffer, root))
+		return nullptr;
+
+	auto* w = World::Build(root["worlds"][0], root["blueprints"]);
+	w->UpdateNeighborList();
+
+	auto wid = w->GetID();
+	for(auto& ff : root["forcefields"]["nonbonded"])
+		for(int i = 1; i <= wid; ++i)
+			ff["rcut"][i] = ff["rcut"][0];
+
+	return w;
+}
+
+// Checks incremental reciprocal space energies over random particle moves 
+// and charge changes. The running energy e must start at the full 
+// evaluation and is kept up to date.
+template<typename F>
+static void CheckIncrementalReciprocal(World& w, const ForceFieldManager& ffm, 
+                                       const F& full, Rand& rand, double& e)
+{
+	for(int k = 0; k < 50; ++k)
+	{
+		auto* p = w.SelectParticle(rand.int32() % w.GetParticleCount());
+		Position dr({rand.doub() - 0.5, rand.doub() - 0.5, rand.doub() - 0.5});
+
+		auto ei = ffm.EvaluateInterEnergy(*p).energy.electrotail;
+		auto de = ffm.EvaluateDeltaEnergy(*p, p->GetPosition() + dr).energy.electrotail;
+		p->SetPosition(p->GetPosition() + dr);
+		auto ef = ffm.EvaluateInterEnergy(*p).energy.electrotail;
+
+		ASSERT_NEAR(ef - ei, de, 1e-8*std::abs(e));
+		e += ef - ei;
+	}
+	ASSERT_NEAR(full(), e, 1e-10*std::abs(e));
+
+	// Charge changes.
+	for(int k = 0; k < 10; ++k)
+	{
+		auto* p = w.SelectPrimitive(rand.int32() % w.GetPrimitiveCount());
+		auto ei = ffm.EvaluateInterEnergy(*p).energy.electrotail;
+		p->SetCharge(p->GetCharge()*(rand.doub() - 0.5));
+		auto ef = ffm.EvaluateInterEnergy(*p).energy.electrotail;
+		e += ef - ei;
+	}
+	ASSERT_NEAR(full(), e, 1e-10*std::abs(e));
+}
+
 // Validate Ewald to NIST 
 // values provided for SPCE water. See ref:
 // http://www.nist.gov/mml/csd/informatics_research/spce_refcalcs.cfm
@@ -63,5 +120,124 @@ TEST(EwaldFF, NISTConfig1)
     ASSERT_NEAR(6.27009E+03-2.84469E+06, E.energy.electrotail, 3.0);
     ASSERT_NEAR(2.80999E+06-7.35708e+06, E.energy.intraelectrostatic, 1.0);
 
+	for(auto* ff : fflist)
+		delete ff;
+	delete w;
+}
+
+// Reciprocal space updated incrementally for particle moves and 
+// charge changes must match a full evaluation.
+TEST(EwaldFF, IncrementalReciprocal)
+{
+	auto& sim = SimInfo::Instance();
+	sim.SetUnits(real);
+
+	Json::Value root;
+	World* w = nullptr;
+	ASSERT_NO_THROW(w = LoadNIST(root));
+	ASSERT_NE(nullptr, w);
+
+	auto wid = w->GetID();
+	for(int i = 1; i <= wid; ++i)
+		root["forcefields"]["electrostatic"]["rcut"][i] = 10.0;
+
+	std::vector<ForceField*> fflist;
+	ForceFieldManager ffm;
+	ASSERT_NO_THROW(ForceField::BuildForceFields(root["forcefields"], &ffm, fflist));
+
+	// Fresh forcefield without cached structure factors.
+	auto full = [&]() {
+		EwaldFF ewald(0.28, 5, 5, 5, CutoffList(wid + 1, 10.0));
+		return ewald.ReciprocalSpace(*w);
+	};
+
+	auto e = ffm.EvaluateEnergy(*w).energy.electrotail;
+	ASSERT_NEAR(full(), e, 1e-10*std::abs(e));
+
+	Rand rand(1234);
+	ASSERT_NO_FATAL_FAILURE(CheckIncrementalReciprocal(*w, ffm, full, rand, e));
+	ASSERT_NEAR(full(), ffm.EvaluateInterEnergy(*w).energy.electrotail, 1e-10*std::abs(e));
+
+	// Volume changes rebuild.
+	w->SetVolume(1.05*w->GetVolume(), true);
+	ASSERT_NEAR(full(), ffm.EvaluateInterEnergy(*w).energy.electrotail, 1e-10*std::abs(e));
+
+	for(auto* ff : fflist)
+		delete ff;
+	delete w;
+}
+
+// Parameters tuned to a tolerance must reproduce a converged sum and 
+// be reported through Serialize.
+TEST(EwaldFF, AutoTune)
+{
+	auto& sim = SimInfo::Instance();
+	sim.SetUnits(real);
+
+	Json::Value root;
+	World* w = nullptr;
+	ASSERT_NO_THROW(w = LoadNIST(root));
+	ASSERT_NE(nullptr, w);
+	auto wid = w->GetID();
+
+	// Worlds are needed to tune.
+	double tol = 1e-5;
+	Json::Value ewald; 
+	ewald["type"] = "Ewald";
+	ewald["tolerance"] = tol;
+	ForceFieldManager ffm0;
+	ASSERT_THROW(ForceField::BuildElectrostatic(ewald, &ffm0), BuildException);
+
+	root["forcefields"]["electrostatic"] = ewald;
+	std::vector<ForceField*> fflist;
+	ForceFieldManager ffm;
+	ASSERT_NO_THROW(ForceField::BuildForceFields(root["forcefields"], &ffm, fflist, {w}));
+
+	EwaldFF* eff = nullptr;
+	for(auto* ff : fflist)
+		if(auto* e = dynamic_cast<EwaldFF*>(ff))
+			eff = e;
+	ASSERT_NE(nullptr, eff);
+	ASSERT_EQ(tol, eff->GetTolerance());
+
+	Json::Value json;
+	eff->Serialize(json);
+	ASSERT_EQ("Ewald", json["type"].asString());
+	ASSERT_GT(json["alpha"].asDouble(), 0);
+	ASSERT_EQ(3u, json["kmax"].size());
+	ASSERT_GT(json["kmax"][0].asInt(), 0);
+	ASSERT_EQ(wid + 1, (int)json["rcut"].size());
+	ASSERT_LE(json["rcut"][wid].asDouble(), 10.0);
+
+	// Compare to a converged sum with the same alpha, since intramolecular 
+	// terms depend on it.
+	Json::Value ref;
+	ref["type"] = "Ewald";
+	ref["alpha"] = json["alpha"];
+	for(int i = 0; i < 3; ++i)
+		ref["kmax"].append(12);
+	for(int i = 0; i <= wid; ++i)
+		ref["rcut"].append(10.0);
+	root["forcefields"]["electrostatic"] = ref;
+	std::vector<ForceField*> reflist;
+	ForceFieldManager refffm;
+	ASSERT_NO_THROW(ForceField::BuildForceFields(root["forcefields"], &refffm, reflist));
+
+	auto total = [&](ForceFieldManager& f) {
+		auto E = f.EvaluateEnergy(*w).energy;
+		return E.interelectrostatic + E.intraelectrostatic + E.electrotail;
+	};
+
+	// Error is relative to sum(q^2)/a for charge spacing a.
+	double qsq = 0;
+	for(int i = 0; i < w->GetPrimitiveCount(); ++i)
+		qsq += std::pow(w->SelectPrimitive(i)->GetCharge(), 2);
+	auto scale = sim.GetChargeConv()*qsq/std::cbrt(w->GetVolume()/w->GetPrimitiveCount());
+	ASSERT_NEAR(total(refffm), total(ffm), tol*scale);
+
+	for(auto* ff : fflist)
+		delete ff;
+	for(auto* ff : reflist)
+		delete ff;
 	delete w;
 }
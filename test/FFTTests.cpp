@@ -0,0 +1,57 @@
+#include "../src/Utils/FFT.h"
+#include "../src/Utils/Rand.h"
+#include "gtest/gtest.h"
+
+using namespace SAPHRON;
+
+// Direct discrete Fourier transform.
+static std::vector<std::complex<double>> DFT(const std::vector<std::complex<double>>& a, int sign)
+{
+	int n = a.size();
+	std::vector<std::complex<double>> b(n);
+	for(int m = 0; m < n; ++m)
+		for(int k = 0; k < n; ++k)
+			b[m] += a[k]*std::polar(1., sign*2.*M_PI*(((long)m*k) % n)/n);
+	return b;
+}
+
+// Powers of two and other lengths must agree with a direct sum.
+TEST(FFT, Sizes)
+{
+	Rand rand(1357);
+	std::vector<std::complex<double>> scratch;
+	for(int n = 1; n <= 100; ++n)
+	{
+		FFT1D fft(n);
+		ASSERT_EQ(n, fft.GetSize());
+
+		std::vector<std::complex<double>> a(n);
+		for(auto& x : a)
+			x = {rand.doub() - 0.5, rand.doub() - 0.5};
+
+		for(int sign : {-1, 1})
+		{
+			auto b = a;
+			fft.Transform(&b[0], sign, scratch);
+			auto ref = DFT(a, sign);
+			for(int k = 0; k < n; ++k)
+				ASSERT_NEAR(0, std::abs(ref[k] - b[k]), 1e-12*n);
+		}
+	}
+}
+
+// Forward then inverse returns n times the input.
+TEST(FFT, RoundTrip)
+{
+	Rand rand(2468);
+	FFT3D fft(6, 8, 15);
+	std::vector<std::complex<double>> a(fft.GetSize());
+	for(auto& x : a)
+		x = {rand.doub() - 0.5, rand.doub() - 0.5};
+
+	auto b = a;
+	fft.Forward(b);
+	fft.Inverse(b);
+	for(size_t k = 0; k < a.size(); ++k)
+		ASSERT_NEAR(0, std::abs(a[k]*(double)fft.GetSize() - b[k]), 1e-10);
+}
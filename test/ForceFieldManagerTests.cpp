@@ -1,7 +1,10 @@
 #include "../src/ForceFields/ForceFieldManager.h"
 #include "../src/ForceFields/LebwohlLasherFF.h"
 #include "../src/ForceFields/FENEFF.h"
+#include "../src/ForceFields/LennardJonesFF.h"
+#include "../src/ForceFields/DSFFF.h"
 #include "../src/Particles/Particle.h"
+#include "../src/Utils/Rand.h"
 #include "gtest/gtest.h"
 
 using namespace SAPHRON;
@@ -76,4 +79,410 @@ TEST(ForceFieldManager, FFIterator)
 	ffm.RemoveBondedForceField("J1", "J1");
 	ASSERT_EQ(1, ffm.BondedForceFieldCount());
 
-}
\ No newline at end of file
+}
+
+TEST(ForceFieldManager, WorldEvaluation)
+{
+	World world(10, 10, 10, 3.0, 0.5);
+	Particle site({0, 0, 0}, {1, 0, 0}, "W1");
+	world.PackWorld({&site}, {1.0}, 500, 0.5);
+
+	LennardJonesFF ff(1.0, 1.0, {2.5});
+	ForceFieldManager ffm;
+	ffm.AddNonBondedForceField("W1", "W1", ff);
+
+	// World evaluation visits each pair once, which must match 
+	// half the sum of per-particle energies.
+	EPTuple ep;
+	for(auto& p : world)
+		ep += ffm.EvaluateInterEnergy(*p);
+
+	auto epw = ffm.EvaluateInterEnergy(world);
+	ASSERT_NEAR(0.5*ep.energy.intervdw, epw.energy.intervdw, 1e-9);
+	ASSERT_NEAR(0.5*ep.pressure.isotropic(), epw.pressure.isotropic(), 1e-9);
+	ASSERT_NEAR(0.5*ep.pressure.pxy, epw.pressure.pxy, 1e-9);
+
+	// Partial sums are reduced in a fixed order, so repeated
+	// evaluations agree exactly.
+	auto epw2 = ffm.EvaluateInterEnergy(world);
+	ASSERT_EQ(epw.energy.intervdw, epw2.energy.intervdw);
+	ASSERT_EQ(epw.pressure.pxy, epw2.pressure.pxy);
+}
+
+TEST(ForceFieldManager, SpeciesTable)
+{
+	Particle s1({0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, "T1");
+	Particle s2({1.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, "T1");
+	Particle s3({0.0, 1.2, 0.0}, {1.0, 0.0, 0.0}, "T2");
+	Particle s4({0.0, 0.0, 3.0}, {1.0, 0.0, 0.0}, "T1");
+
+	s1.AddNeighbor(&s2);
+	s1.AddNeighbor(&s3);
+	s1.AddNeighbor(&s4);
+
+	LennardJonesFF lj(1.0, 1.0, {2.5});
+	LennardJonesFF lj2(0.5, 1.0, {2.5});
+
+	ForceFieldManager ffm;
+	ffm.AddNonBondedForceField("T1", "T1", lj);
+	
+	// s4 is beyond the cutoff and T1-T2 has no forcefield.
+	auto e12 = lj.Evaluate(s1, s2, {1.0, 0.0, 0.0}, 0).energy;
+	ASSERT_DOUBLE_EQ(e12, ffm.EvaluateInterEnergy(s1).energy.intervdw);
+
+	ffm.AddNonBondedForceField("T2", "T1", lj2);
+	auto e13 = lj2.Evaluate(s1, s3, {0.0, 1.2, 0.0}, 0).energy;
+	ASSERT_DOUBLE_EQ(e12 + e13, ffm.EvaluateInterEnergy(s1).energy.intervdw);
+
+	// Species registered after forcefields have no interactions.
+	Particle s5({1.0, 1.0, 0.0}, {1.0, 0.0, 0.0}, "T3");
+	s1.AddNeighbor(&s5);
+	ASSERT_DOUBLE_EQ(e12 + e13, ffm.EvaluateInterEnergy(s1).energy.intervdw);
+
+	ffm.RemoveNonBondedForceField("T1", "T1");
+	ASSERT_DOUBLE_EQ(e13, ffm.EvaluateInterEnergy(s1).energy.intervdw);
+}
+
+TEST(ForceFieldManager, PairKernels)
+{
+	World world(10, 10, 10, 3.0, 0.5);
+	Particle site({0, 0, 0}, {1, 0, 0}, "K1");
+	Particle other({0, 0, 0}, {1, 0, 0}, "K2");
+	world.PackWorld({&site}, {1.0}, 300, 0.3);
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+		world.SelectParticle(i)->SetCharge(i % 2 ? 1.0 : -1.0);
+
+	LennardJonesFF lj(1.0, 1.0, {2.5});
+	LebwohlLasherFF ll(1.0, 0);
+	DSFFF dsf(0.2, {2.5});
+
+	ForceFieldManager ffm;
+	ASSERT_EQ("Generic", ffm.GetKernelName());
+	ffm.AddNonBondedForceField("K1", "K1", lj);
+	ASSERT_EQ("LennardJones", ffm.GetKernelName());
+	ffm.SetElectrostaticForcefield(dsf);
+	ASSERT_EQ("LennardJones+DSF", ffm.GetKernelName());
+
+	// Reference energies through virtual dispatch.
+	double evdw = 0, eelec = 0;
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+		for(int j = i + 1; j < world.GetParticleCount(); ++j)
+		{
+			auto* pi = world.SelectParticle(i);
+			auto* pj = world.SelectParticle(j);
+			Position rij = pi->GetPosition() - pj->GetPosition();
+			world.ApplyMinimumImage(&rij);
+			evdw += lj.Evaluate(*pi, *pj, rij, world.GetID()).energy;
+			eelec += dsf.Evaluate(*pi, *pj, rij, world.GetID()).energy;
+		}
+
+	auto ep = ffm.EvaluateInterEnergy(world);
+	ASSERT_NEAR(evdw, ep.energy.intervdw, 1e-9);
+	ASSERT_NEAR(eelec, ep.energy.interelectrostatic, 1e-9);
+
+	// Mixed forcefield types use the generic kernel.
+	ffm.AddNonBondedForceField("K2", "K2", ll);
+	ASSERT_EQ("Generic+DSF", ffm.GetKernelName());
+	auto epg = ffm.EvaluateInterEnergy(world);
+	ASSERT_NEAR(ep.energy.intervdw, epg.energy.intervdw, 1e-9);
+	ASSERT_NEAR(ep.energy.interelectrostatic, epg.energy.interelectrostatic, 1e-9);
+	ASSERT_NEAR(ep.pressure.isotropic(), epg.pressure.isotropic(), 1e-9);
+
+	ffm.ResetElectrostaticForceField();
+	ffm.RemoveNonBondedForceField("K2", "K2");
+	ASSERT_EQ("LennardJones", ffm.GetKernelName());
+}
+
+TEST(ForceFieldManager, EnergyOnly)
+{
+	World world(10, 10, 10, 3.0, 0.5);
+	Particle site({0, 0, 0}, {1, 0, 0}, "E1");
+	world.PackWorld({&site}, {1.0}, 300, 0.3);
+	world.UpdateNeighborList();
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+		world.SelectParticle(i)->SetCharge(i % 2 ? 1.0 : -1.0);
+
+	// Cutoffs are indexed by world ID.
+	CutoffList rc(world.GetID() + 1, 2.5);
+	LennardJonesFF lj(1.0, 1.0, rc);
+	DSFFF dsf(0.2, rc);
+
+	ForceFieldManager ffm;
+	ffm.AddNonBondedForceField("E1", "E1", lj);
+
+	// Energies must match the full evaluation with and without 
+	// electrostatics, while the pressure is left out.
+	for(int k = 0; k < 2; ++k)
+	{
+		for(int i = 0; i < world.GetParticleCount(); i += 7)
+		{
+			auto& p = *world.SelectParticle(i);
+			auto ep = ffm.EvaluateEnergy(p);
+			auto eo = ffm.EvaluateEnergyOnly(p);
+			ASSERT_NEAR(ep.energy.total(), eo.energy.total(), 1e-10);
+			ASSERT_NEAR(ep.energy.interelectrostatic, eo.energy.interelectrostatic, 1e-10);
+			ASSERT_NE(0, ep.pressure.isotropic());
+			ASSERT_EQ(0, eo.pressure.isotropic());
+		}
+		ffm.SetElectrostaticForcefield(dsf);
+	}
+
+	// World pressure is recomputed on demand.
+	ASSERT_TRUE(world.IsPressureValid());
+	world.InvalidatePressure();
+	ASSERT_FALSE(world.IsPressureValid());
+	world.SetPressure(ffm.EvaluateEnergy(world).pressure);
+	ASSERT_TRUE(world.IsPressureValid());
+}
+
+TEST(ForceFieldManager, DeltaEnergy)
+{
+	World world(10, 10, 10, 3.0, 1.0);
+	Particle site({0, 0, 0}, {1, 0, 0}, "D1");
+	world.PackWorld({&site}, {1.0}, 300, 0.3);
+	world.UpdateNeighborList();
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+		world.SelectParticle(i)->SetCharge(i % 2 ? 1.0 : -1.0);
+
+	CutoffList rc(world.GetID() + 1, 2.5);
+	LennardJonesFF lj(1.0, 1.0, rc);
+	LebwohlLasherFF ll(1.0, 0);
+	DSFFF dsf(0.2, rc);
+
+	ForceFieldManager ffm;
+	ffm.AddNonBondedForceField("D1", "D1", lj);
+	ffm.SetElectrostaticForcefield(dsf);
+
+	// Translations within the skin must match moving the particle.
+	Rand rand(1234);
+	for(int i = 0; i < world.GetParticleCount(); i += 5)
+	{
+		auto* p = world.SelectParticle(i);
+		auto posi = p->GetPosition();
+		Position posf = posi + Position({0.4*(rand.doub() - 0.5), 0.4*(rand.doub() - 0.5), 0.4*(rand.doub() - 0.5)});
+		world.ApplyPeriodicBoundaries(&posf);
+		ASSERT_TRUE(world.IsNeighborListValid(p, posf - posi));
+
+		auto ei = ffm.EvaluateInterEnergy(*p);
+		auto de = ffm.EvaluateDeltaEnergy(*p, posf);
+		ASSERT_EQ(posi[0], p->GetPosition()[0]);
+		p->SetPosition(posf);
+		auto ef = ffm.EvaluateInterEnergy(*p);
+		p->SetPosition(posi);
+
+		ASSERT_NEAR(ef.energy.intervdw - ei.energy.intervdw, de.energy.intervdw, 1e-10);
+		ASSERT_NEAR(ef.energy.interelectrostatic - ei.energy.interelectrostatic, de.energy.interelectrostatic, 1e-10);
+	}
+
+	// Director changes with an anisotropic forcefield. Trial states 
+	// reuse scratch particles rather than creating new ones.
+	ffm.ResetElectrostaticForceField();
+	ffm.RemoveNonBondedForceField("D1", "D1");
+	ffm.AddNonBondedForceField("D1", "D1", ll);
+	ffm.EvaluateDeltaEnergy(*world.SelectParticle(0), world.SelectParticle(0)->GetPosition(), {0, 0, 1});
+	auto nparticles = Particle::GetParticleMap().size();
+	for(int i = 0; i < world.GetParticleCount(); i += 5)
+	{
+		auto* p = world.SelectParticle(i);
+		auto di = p->GetDirector();
+		Director df({rand.doub() - 0.5, rand.doub() - 0.5, rand.doub() - 0.5});
+		df /= fnorm(df);
+
+		auto ei = ffm.EvaluateInterEnergy(*p);
+		auto de = ffm.EvaluateDeltaEnergy(*p, p->GetPosition(), df);
+		p->SetDirector(df);
+		auto ef = ffm.EvaluateInterEnergy(*p);
+		p->SetDirector(di);
+
+		ASSERT_NE(0, de.energy.intervdw);
+		ASSERT_NEAR(ef.energy.intervdw - ei.energy.intervdw, de.energy.intervdw, 1e-10);
+	}
+	ASSERT_EQ(nparticles, Particle::GetParticleMap().size());
+}
+
+TEST(ForceFieldManager, EnergyCache)
+{
+	World world(10, 10, 10, 3.0, 1.0);
+	Particle site({0, 0, 0}, {1, 0, 0}, "C1");
+	world.PackWorld({&site}, {1.0}, 300, 0.3);
+	world.UpdateNeighborList();
+
+	CutoffList rc(world.GetID() + 1, 2.5);
+	LennardJonesFF lj(1.0, 1.0, rc);
+
+	ForceFieldManager ffm;
+	ffm.AddNonBondedForceField("C1", "C1", lj);
+	ffm.SetEnergyCache(true);
+
+	// Repeated evaluations are served from the cache.
+	auto* p = world.SelectParticle(0);
+	auto e1 = ffm.EvaluateEnergy(*p);
+	ASSERT_TRUE(world.IsTrackingEnergyStamps());
+	auto stamp = p->GetEnergyStamp();
+	auto e2 = ffm.EvaluateEnergy(*p);
+	ASSERT_EQ(e1.energy.total(), e2.energy.total());
+	ASSERT_EQ(stamp, p->GetEnergyStamp());
+	ASSERT_EQ(0, ffm.EvaluateEnergyOnly(*p).pressure.isotropic());
+
+	// Moving a neighbor invalidates the particle, moving 
+	// anything else does not.
+	auto* n = p->GetNeighbors()[0];
+	n->SetPosition(n->GetPosition() + Position({0.1, 0, 0}));
+	ASSERT_NE(stamp, p->GetEnergyStamp());
+	stamp = p->GetEnergyStamp();
+
+	Particle* far = nullptr;
+	auto nbrs = p->GetNeighbors();
+	for(auto& q : world)
+		if(q != p && std::find(nbrs.begin(), nbrs.end(), q) == nbrs.end())
+			far = q;
+	ASSERT_NE(nullptr, far);
+	far->SetPosition(far->GetPosition() + Position({0.1, 0, 0}));
+	ASSERT_EQ(stamp, p->GetEnergyStamp());
+
+	// Removing a neighbor invalidates the particle.
+	world.RemoveParticle(n);
+	ASSERT_NE(stamp, p->GetEnergyStamp());
+	world.AddParticle(n);
+
+	// Cached energies are owned by particles so they do not survive 
+	// deletion, even if a new particle takes the same address.
+	auto* d = world.SelectParticle(1);
+	ffm.EvaluateEnergy(*d);
+	Position pos = d->GetPosition() + Position({0.05, 0, 0});
+	world.ApplyPeriodicBoundaries(&pos);
+	world.RemoveParticle(d);
+	delete d;
+	d = new Particle(pos, {1, 0, 0}, "C1");
+	world.AddParticle(d);
+	ASSERT_NEAR(ffm.EvaluateInterEnergy(*d).energy.total(), ffm.EvaluateEnergy(*d).energy.total(), 1e-10);
+
+	// Cached energies must agree with fresh ones after random moves.
+	Rand rand(4321);
+	for(int k = 0; k < 2000; ++k)
+	{
+		auto* q = world.SelectParticle(rand.int32() % world.GetParticleCount());
+		if(k % 2)
+		{
+			Position pos = q->GetPosition() + Position({0.4*(rand.doub() - 0.5), 0.4*(rand.doub() - 0.5), 0.4*(rand.doub() - 0.5)});
+			world.ApplyPeriodicBoundaries(&pos);
+			q->SetPosition(pos);
+			world.CheckNeighborListUpdate(q);
+		}
+		ffm.EvaluateEnergy(*q);
+	}
+	ASSERT_NEAR(0, ffm.CheckEnergyCache(world), 1e-10);
+
+	// Volume changes invalidate everything.
+	world.SetVolume(1.1*world.GetVolume(), true);
+	ASSERT_NEAR(0, ffm.CheckEnergyCache(world), 1e-10);
+	ASSERT_NE(stamp, p->GetEnergyStamp());
+}
+
+TEST(ForceFieldManager, EnergyCacheNested)
+{
+	// Molecules made of two groups of two beads.
+	auto molecule = [](const Position& x) {
+		auto* m = new Particle("M");
+		for(int i = 0; i < 2; ++i)
+		{
+			auto* g = new Particle("G");
+			for(int j = 0; j < 2; ++j)
+				g->AddChild(new Particle(x + Position({1.1*(2*i + j), 0, 0}), {1, 0, 0}, "B"));
+			m->AddChild(g);
+		}
+		return m;
+	};
+
+	World world(12, 12, 12, 3.0, 1.0);
+	auto* a = molecule({2, 2, 2});
+	auto* b = molecule({2, 3.2, 2});
+	world.AddParticle(a);
+	world.AddParticle(b);
+	world.UpdateNeighborList();
+
+	CutoffList rc(world.GetID() + 1, 2.5);
+	LennardJonesFF lj(1.0, 1.0, rc);
+
+	ForceFieldManager ffm;
+	ffm.AddNonBondedForceField("B", "B", lj);
+	ffm.SetEnergyCache(true);
+
+	auto* bead = a->GetChildren()[0]->GetChildren()[0];
+	auto* cousin = a->GetChildren()[1]->GetChildren()[1];
+	ffm.EvaluateEnergy(*a);
+	ffm.EvaluateEnergy(*b);
+	ffm.EvaluateEnergy(*cousin);
+	auto sa = a->GetEnergyStamp();
+	auto sb = b->GetEnergyStamp();
+	auto sc = cousin->GetEnergyStamp();
+
+	// Moving a bead touches its whole molecule and every 
+	// ancestor of its neighbors.
+	bead->SetPosition(bead->GetPosition() + Position({0, 0.05, 0}));
+	ASSERT_NE(sa, a->GetEnergyStamp());
+	ASSERT_NE(sb, b->GetEnergyStamp());
+	ASSERT_NE(sc, cousin->GetEnergyStamp());
+	ASSERT_NEAR(0, ffm.CheckEnergyCache(world), 1e-10);
+
+	ffm.EvaluateEnergy(*a);
+	ffm.EvaluateEnergy(*b);
+	ffm.EvaluateEnergy(*cousin);
+	ASSERT_NEAR(0, ffm.CheckEnergyCache(world), 1e-10);
+}
+
+TEST(ForceFieldManager, IntraScaling)
+{
+	// Linear chain of five beads.
+	Particle chain("Chain");
+	for(int i = 0; i < 5; ++i)
+		chain.AddChild(new Particle({1.1*i, 0.1*(i % 2), 0.0}, {1.0, 0.0, 0.0}, "B"));
+
+	auto& beads = chain.GetChildren();
+	for(int i = 0; i < 4; ++i)
+	{
+		beads[i]->AddBondedNeighbor(beads[i+1]);
+		beads[i+1]->AddBondedNeighbor(beads[i]);
+	}
+
+	LennardJonesFF lj(1.0, 1.0, {10.0});
+	ForceFieldManager ffm;
+	ffm.AddNonBondedForceField("B", "B", lj);
+
+	auto e = [&](int i, int j) {
+		return lj.Evaluate(*beads[i], *beads[j], beads[i]->GetPosition() - beads[j]->GetPosition(), 0).energy;
+	};
+
+	// Bonded neighbors are excluded by default.
+	auto e13 = e(0, 2) + e(1, 3) + e(2, 4);
+	auto e14 = e(0, 3) + e(1, 4);
+	auto e15 = e(0, 4);
+	ASSERT_NEAR(e13 + e14 + e15, ffm.EvaluateIntraEnergy(chain).energy.intravdw, 1e-12);
+	ASSERT_NEAR(e(0, 2) + e(0, 3) + e(0, 4), ffm.EvaluateIntraEnergy(*beads[0]).energy.intravdw, 1e-12);
+
+	// Exclude 1-3 and halve 1-4.
+	ffm.SetIntraScaling(0., 0., 0.5);
+	ASSERT_NEAR(0.5*e14 + e15, ffm.EvaluateIntraEnergy(chain).energy.intravdw, 1e-12);
+	ASSERT_NEAR(0.5*e(0, 3) + e(0, 4), ffm.EvaluateIntraEnergy(*beads[0]).energy.intravdw, 1e-12);
+	ASSERT_NEAR(0.5*e(1, 4), ffm.EvaluateIntraEnergy(*beads[1]).energy.intravdw, 1e-12);
+
+	// Breaking a bond updates the pair set.
+	beads[1]->RemoveBondedNeighbor(beads[2]);
+	beads[2]->RemoveBondedNeighbor(beads[1]);
+	auto broken = e(0, 2) + e(0, 3) + e(0, 4) + e(1, 2) + e(1, 3) + e(1, 4);
+	ASSERT_NEAR(broken, ffm.EvaluateIntraEnergy(chain).energy.intravdw, 1e-12);
+
+	// Molecules of the same species with other bonds get their own pair 
+	// sets, while copies share the topology of the original.
+	Particle loose("Chain");
+	for(int i = 0; i < 5; ++i)
+		loose.AddChild(new Particle(beads[i]->GetPosition(), {1.0, 0.0, 0.0}, "B"));
+	Particle copy(chain);
+	ASSERT_EQ(chain.GetTopologyStamp(), copy.GetTopologyStamp());
+	ASSERT_NE(chain.GetTopologyStamp(), loose.GetTopologyStamp());
+
+	auto all = broken + e(0, 1) + e(2, 3) + e(2, 4) + e(3, 4);
+	ASSERT_NEAR(all, ffm.EvaluateIntraEnergy(loose).energy.intravdw, 1e-12);
+	ASSERT_NEAR(broken, ffm.EvaluateIntraEnergy(chain).energy.intravdw, 1e-12);
+	ASSERT_NEAR(broken, ffm.EvaluateIntraEnergy(copy).energy.intravdw, 1e-12);
+}
@@ -0,0 +1,166 @@
+#include "../src/ForceFields/LennardJonesBatch.h"
+#include "../src/ForceFields/LennardJonesFF.h"
+#include "../src/ForceFields/LennardJonesTSFF.h"
+#include "../src/Particles/Particle.h"
+#include "../src/Worlds/World.h"
+#include "../src/Utils/Rand.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace SAPHRON;
+
+namespace
+{
+	struct KernelInfo
+	{
+		const char* name;
+		LennardJonesBatchKernel kernel;
+	};
+
+	// Kernels supported by this CPU.
+	std::vector<KernelInfo> SupportedKernels()
+	{
+		std::vector<KernelInfo> kernels = {{"Scalar", &EvaluateLennardJonesBatchScalar}};
+		if(HasLennardJonesBatchAVX2())
+			kernels.push_back({"AVX2", &EvaluateLennardJonesBatchAVX2});
+		if(HasLennardJonesBatchAVX512())
+			kernels.push_back({"AVX-512", &EvaluateLennardJonesBatchAVX512});
+		return kernels;
+	}
+
+	// Random raw distances in a periodic box of length l.
+	std::vector<Position> RandomDistances(int n, double l)
+	{
+		Rand rand(4512);
+		std::vector<Position> d;
+		for(int i = 0; i < n; ++i)
+			d.push_back({l*(rand.doub() - 0.5)*2.0, l*(rand.doub() - 0.5)*2.0, l*(rand.doub() - 0.5)*2.0});
+		return d;
+	}
+
+	// Current pair-wise path: minimum image and inlined pair evaluation.
+	template<typename FF>
+	double EvaluatePairwise(const FF& ff, const World& world, const std::vector<Position>& distances, 
+	                        int repeat, const Particle& p1, const Particle& p2)
+	{
+		double e = 0, xx = 0;
+		for(int r = 0; r < repeat; ++r)
+			for(auto& d : distances)
+			{
+				Position rij = d;
+				world.ApplyMinimumImage(&rij);
+				auto ep = ff.EvaluatePair(p1, p2, rij, fdot(rij, rij), 0);
+				e += ep.energy;
+				xx += ep.virial*rij[0]*rij[0];
+			}
+		return e + 0*xx;
+	}
+
+	// Batched path including gathering.
+	template<typename FF>
+	double EvaluateBatched(const FF& ff, LennardJonesBatchKernel kernel, const LennardJonesBatchBox& box, 
+	                       const std::vector<Position>& distances, int repeat)
+	{
+		LennardJonesBatchSums sums;
+		for(int r = 0; r < repeat; ++r)
+			for(size_t b = 0; b < distances.size(); b += LJ_BATCH_SIZE)
+			{
+				LennardJonesBatch batch;
+				for(int k = 0; k < LJ_BATCH_SIZE; ++k)
+				{
+					auto& d = distances[b + k];
+					batch.dx[k] = d[0];
+					batch.dy[k] = d[1];
+					batch.dz[k] = d[2];
+					ff.GetBatchParameters(0, batch.eps4[k], batch.sigsq[k], batch.rcsq[k], batch.shift[k]);
+				}
+				kernel(batch, LJ_BATCH_SIZE, box, sums);
+			}
+		return LennardJonesBatchSums::Total(sums.energy);
+	}
+
+	// Batched kernels must agree with the pair-wise path for 
+	// distances within the neighbor radius.
+	template<typename FF>
+	void CheckPairwise(const FF& ff)
+	{
+		double l = 10.0;
+		World world(l, l, l, 3.0, 0.5);
+		LennardJonesBatchBox box = {{l, l, l}, {l/2.0, l/2.0, l/2.0}};
+		Particle p1("LJ"), p2("LJ");
+
+		auto distances = RandomDistances(4096, 3.5/sqrt(3.0));
+		auto e = EvaluatePairwise(ff, world, distances, 1, p1, p2);
+		for(auto& info : SupportedKernels())
+		{
+			auto eb = EvaluateBatched(ff, info.kernel, box, distances, 1);
+			ASSERT_NEAR(e, eb, 1e-8*fabs(e)) << info.name;
+		}
+	}
+}
+
+// Batched kernels must agree with the forcefields for every batch size.
+TEST(LennardJonesBatch, Kernels)
+{
+	double l = 6.0;
+	World world(l, l, l, 3.0, 0.5);
+	LennardJonesBatchBox box = {{l, l, 0.0}, {l/2.0, l/2.0, 0.0}};
+	world.SetPeriodicZ(false);
+
+	Particle p1("LJ"), p2("LJ");
+	LennardJonesFF lj(1.0, 1.0, {2.5});
+	LennardJonesTSFF ljts(1.5, 1.1, {2.5});
+	auto distances = RandomDistances(2000, l);
+
+	for(auto& info : SupportedKernels())
+	{
+		for(int n = 1; n <= LJ_BATCH_SIZE; ++n)
+		{
+			LennardJonesBatchSums sums;
+			double e = 0, xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+			for(size_t b = 0; b + n <= distances.size(); b += n)
+			{
+				LennardJonesBatch batch;
+				for(int k = 0; k < n; ++k)
+				{
+					auto& d = distances[b + k];
+					batch.dx[k] = d[0];
+					batch.dy[k] = d[1];
+					batch.dz[k] = d[2];
+					if(k % 2)
+						lj.GetBatchParameters(0, batch.eps4[k], batch.sigsq[k], batch.rcsq[k], batch.shift[k]);
+					else
+						ljts.GetBatchParameters(0, batch.eps4[k], batch.sigsq[k], batch.rcsq[k], batch.shift[k]);
+
+					auto rij = d;
+					world.ApplyMinimumImage(&rij);
+					auto ep = (k % 2) ? lj.Evaluate(p1, p2, rij, 0) : ljts.Evaluate(p1, p2, rij, 0);
+					e += ep.energy;
+					xx += ep.virial*rij[0]*rij[0];
+					xy += ep.virial*rij[0]*rij[1];
+					xz += ep.virial*rij[0]*rij[2];
+					yy += ep.virial*rij[1]*rij[1];
+					yz += ep.virial*rij[1]*rij[2];
+					zz += ep.virial*rij[2]*rij[2];
+				}
+				info.kernel(batch, n, box, sums);
+			}
+
+			auto total = &LennardJonesBatchSums::Total;
+			ASSERT_NEAR(e, total(sums.energy), 1e-8*fabs(e)) << info.name << " n = " << n;
+			ASSERT_NEAR(xx, total(sums.xx), 1e-8*fabs(xx)) << info.name << " n = " << n;
+			ASSERT_NEAR(xy, total(sums.xy), 1e-8*fabs(xx)) << info.name << " n = " << n;
+			ASSERT_NEAR(xz, total(sums.xz), 1e-8*fabs(xx)) << info.name << " n = " << n;
+			ASSERT_NEAR(yy, total(sums.yy), 1e-8*fabs(yy)) << info.name << " n = " << n;
+			ASSERT_NEAR(yz, total(sums.yz), 1e-8*fabs(yy)) << info.name << " n = " << n;
+			ASSERT_NEAR(zz, total(sums.zz), 1e-8*fabs(zz)) << info.name << " n = " << n;
+		}
+	}
+}
+
+// Batched kernels through LennardJonesFF and LennardJonesTSFF parameters.
+TEST(LennardJonesBatch, Pairwise)
+{
+	CheckPairwise(LennardJonesFF(1.0, 1.0, {3.0}));
+	CheckPairwise(LennardJonesTSFF(1.0, 1.0, {3.0}));
+}
@@ -0,0 +1,122 @@
+#include "../src/Utils/Profiler.h"
+#include "gtest/gtest.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <thread>
+
+using namespace SAPHRON;
+
+TEST(Profiler, DefaultBehavior)
+{
+	auto& prof = Profiler::Instance();
+	prof.Reset();
+
+	// Registering a name twice returns the same handle.
+	auto outer = prof.Register("test_outer");
+	auto inner = prof.Register("test_inner");
+	ASSERT_NE(outer, inner);
+	ASSERT_EQ(outer, prof.Register("test_outer"));
+
+	for(int i = 0; i < 3; ++i)
+	{
+		prof.Start(outer);
+		prof.Start(inner);
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		prof.Stop();
+		prof.Stop();
+	}
+
+	// Inner section is also timed on its own at top level.
+	prof.Start(inner);
+	prof.Stop();
+
+	auto report = prof.GetReport();
+	ASSERT_EQ(3u, report.size());
+
+	ASSERT_EQ("test_outer", report[0].name);
+	ASSERT_EQ(0, report[0].depth);
+	ASSERT_EQ(3, report[0].calls);
+
+	ASSERT_EQ("test_inner", report[1].name);
+	ASSERT_EQ(1, report[1].depth);
+	ASSERT_EQ(3, report[1].calls);
+	ASSERT_GE(report[1].seconds, 0.006);
+	ASSERT_GE(report[0].seconds, report[1].seconds);
+
+	ASSERT_EQ("test_inner", report[2].name);
+	ASSERT_EQ(0, report[2].depth);
+	ASSERT_EQ(1, report[2].calls);
+
+	// Total sums over enclosing sections.
+	ASSERT_DOUBLE_EQ(report[1].seconds + report[2].seconds, prof.GetTotal(inner));
+	ASSERT_GE(prof.GetElapsed(), report[0].seconds);
+
+	prof.Reset();
+	ASSERT_EQ(0u, prof.GetReport().size());
+	ASSERT_EQ(0.0, prof.GetTotal(outer));
+}
+
+TEST(Profiler, Threads)
+{
+	auto& prof = Profiler::Instance();
+	prof.Reset();
+
+	auto h = prof.Register("test_threads");
+
+	// Per thread trees are merged into one section.
+	#pragma omp parallel
+	{
+		prof.Start(h);
+		prof.Stop();
+	}
+
+	int n = 1;
+	#ifdef _OPENMP
+	n = omp_get_max_threads();
+	#endif
+
+	auto report = prof.GetReport();
+	ASSERT_EQ(1u, report.size());
+	ASSERT_EQ("test_threads", report[0].name);
+	ASSERT_EQ(n, report[0].calls);
+	prof.Reset();
+}
+
+TEST(Profiler, NestedTeams)
+{
+	auto& prof = Profiler::Instance();
+	prof.Reset();
+
+	auto h = prof.Register("test_nested");
+
+	// Thread numbers repeat across nested teams but every thread 
+	// records into its own tree.
+	#ifdef _OPENMP
+	int levels = omp_get_max_active_levels();
+	omp_set_max_active_levels(2);
+	#endif
+
+	long n = 0;
+	#pragma omp parallel num_threads(2) reduction(+:n)
+	{
+		#pragma omp parallel num_threads(2) reduction(+:n)
+		{
+			for(int i = 0; i < 1000; ++i)
+			{
+				prof.Start(h);
+				prof.Stop();
+				++n;
+			}
+		}
+	}
+
+	#ifdef _OPENMP
+	omp_set_max_active_levels(levels);
+	#endif
+
+	auto report = prof.GetReport();
+	ASSERT_EQ(1u, report.size());
+	ASSERT_EQ(n, report[0].calls);
+	prof.Reset();
+}
@@ -0,0 +1,239 @@
+#include "../src/ForceFields/SPMEFF.h"
+#include "../src/ForceFields/EwaldFF.h"
+#include "../src/ForceFields/ForceFieldManager.h"
+#include "../src/Simulation/SimInfo.h"
+#include "../src/Particles/Particle.h"
+#include "../src/Simulation/SimException.h"
+#include "../src/Worlds/World.h"
+#include "../src/Utils/Rand.h"
+#include "gtest/gtest.h"
+
+using namespace SAPHRON;
+
+// Loads NIST SPC/E configuration with SPME electrostatics.
+static World* LoadNIST(Json::Value& root)
+{
+	std::ifstream t("../test/nist_spce_ewald1.json");
+	std::stringstream buffer;
+	buffer << t.rdbuf();
+	Json::Reader reader;
+	if(!reader.parse(buffer, root))
+		return nullptr;
+
+	auto* w = World::Build(root["worlds"][0], root["blueprints"]);
+	w->UpdateNeighborList();
+
+	// Cutoffs are indexed by world ID.
+	auto wid = w->GetID();
+	for(auto& ff : root["forcefields"]["nonbonded"])
+		for(int i = 1; i <= wid; ++i)
+			ff["rcut"][i] = ff["rcut"][0];
+
+	Json::Value spme;
+	spme["type"] = "SPME";
+	spme["alpha"] = 0.28;
+	spme["order"] = 6;
+	for(int i = 0; i < 3; ++i)
+		spme["grid"].append(32);
+	for(int i = 0; i <= wid; ++i)
+		spme["rcut"].append(10.0);
+	root["forcefields"]["electrostatic"] = spme;
+
+	return w;
+}
+
+// Checks local mesh updates over random particle moves and charge changes. 
+// The running energy e must start at the full evaluation and is kept up 
+// to date.
+template<typename F>
+static void CheckIncrementalReciprocal(World& w, const ForceFieldManager& ffm, 
+                                       const F& full, Rand& rand, double& e)
+{
+	for(int k = 0; k < 50; ++k)
+	{
+		auto* p = w.SelectParticle(rand.int32() % w.GetParticleCount());
+		Position dr({rand.doub() - 0.5, rand.doub() - 0.5, rand.doub() - 0.5});
+
+		auto ei = ffm.EvaluateInterEnergy(*p).energy.electrotail;
+		auto de = ffm.EvaluateDeltaEnergy(*p, p->GetPosition() + dr).energy.electrotail;
+		p->SetPosition(p->GetPosition() + dr);
+		auto ef = ffm.EvaluateInterEnergy(*p).energy.electrotail;
+
+		ASSERT_NEAR(ef - ei, de, 1e-8*std::abs(e));
+		e += ef - ei;
+	}
+	ASSERT_NEAR(full(), e, 1e-10*std::abs(e));
+
+	// Charge changes.
+	for(int k = 0; k < 10; ++k)
+	{
+		auto* p = w.SelectPrimitive(rand.int32() % w.GetPrimitiveCount());
+		auto ei = ffm.EvaluateInterEnergy(*p).energy.electrotail;
+		p->SetCharge(p->GetCharge()*(rand.doub() - 0.5));
+		auto ef = ffm.EvaluateInterEnergy(*p).energy.electrotail;
+		e += ef - ei;
+	}
+	ASSERT_NEAR(full(), e, 1e-10*std::abs(e));
+}
+
+// Validate SPME against Ewald and NIST values for SPCE water. See ref:
+// http://www.nist.gov/mml/csd/informatics_research/spce_refcalcs.cfm
+TEST(SPMEFF, NISTConfig1)
+{
+	auto& sim = SimInfo::Instance();
+	sim.SetUnits(real);
+
+	Json::Value root;
+	World* w = nullptr;
+	ASSERT_NO_THROW(w = LoadNIST(root));
+	ASSERT_NE(nullptr, w);
+	ASSERT_EQ(300, w->GetPrimitiveCount());
+
+	std::vector<ForceField*> fflist;
+	ForceFieldManager ffm;
+	ASSERT_NO_THROW(ForceField::BuildForceFields(root["forcefields"], &ffm, fflist));
+
+	auto E = ffm.EvaluateEnergy(*w);
+	E.energy /= sim.GetkB();
+
+	// Real space is the same as Ewald.
+	ASSERT_NEAR(-5.58889E+05, E.energy.interelectrostatic, 1e-1);
+	ASSERT_NEAR(2.80999E+06-7.35708e+06, E.energy.intraelectrostatic, 1.0);
+
+	// NIST reciprocal energies are truncated at kmax = 5, compare to a
+	// converged Ewald sum instead.
+	auto wid = w->GetID();
+	EwaldFF ewald(0.28, 10, 10, 10, CutoffList(wid + 1, 10.0));
+	SPMEFF spme(0.28, 32, 32, 32, 6, CutoffList(wid + 1, 10.0));
+
+	// Self terms cancel, the rest is about 6270 K.
+	auto eewald = ewald.ReciprocalSpace(*w);
+	ASSERT_NEAR(eewald, spme.ReciprocalSpace(*w), 1e-5*6.27009E+03*sim.GetkB());
+	ASSERT_NEAR(eewald, E.energy.electrotail*sim.GetkB(), 1e-5*6.27009E+03*sim.GetkB());
+
+	for(auto* ff : fflist)
+		delete ff;
+	delete w;
+}
+
+// Local mesh updates for particle moves and charge changes must match
+// a full evaluation.
+TEST(SPMEFF, IncrementalReciprocal)
+{
+	auto& sim = SimInfo::Instance();
+	sim.SetUnits(real);
+
+	Json::Value root;
+	World* w = nullptr;
+	ASSERT_NO_THROW(w = LoadNIST(root));
+	ASSERT_NE(nullptr, w);
+
+	std::vector<ForceField*> fflist;
+	ForceFieldManager ffm;
+	ASSERT_NO_THROW(ForceField::BuildForceFields(root["forcefields"], &ffm, fflist));
+
+	// Fresh forcefield without a cached mesh.
+	auto wid = w->GetID();
+	auto full = [&]() {
+		SPMEFF spme(0.28, 32, 32, 32, 6, CutoffList(wid + 1, 10.0));
+		return spme.ReciprocalSpace(*w);
+	};
+
+	auto e = ffm.EvaluateEnergy(*w).energy.electrotail;
+	ASSERT_NEAR(full(), e, 1e-10*std::abs(e));
+
+	Rand rand(4321);
+	ASSERT_NO_FATAL_FAILURE(CheckIncrementalReciprocal(*w, ffm, full, rand, e));
+	ASSERT_NEAR(full(), ffm.EvaluateInterEnergy(*w).energy.electrotail, 1e-10*std::abs(e));
+
+	// Volume changes rebuild.
+	w->SetVolume(1.05*w->GetVolume(), true);
+	ASSERT_NEAR(full(), ffm.EvaluateInterEnergy(*w).energy.electrotail, 1e-10*std::abs(e));
+
+	for(auto* ff : fflist)
+		delete ff;
+	delete w;
+}
+
+// Slab worlds with the Yeh-Berkowitz correction must not depend on 
+// the vacuum gap and must be consistent under local mesh updates.
+TEST(SPMEFF, Slab)
+{
+	auto& sim = SimInfo::Instance();
+	sim.SetUnits(real);
+
+	Json::Value root;
+	World* w = nullptr;
+	ASSERT_NO_THROW(w = LoadNIST(root));
+	ASSERT_NE(nullptr, w);
+	w->SetPeriodicZ(false);
+	w->UpdateNeighborList();
+
+	// Same mesh spacing for both gaps.
+	auto wid = w->GetID();
+	SPMEFF spme4(0.28, 32, 32, 128, 6, CutoffList(wid + 1, 10.0), 4.);
+	SPMEFF spme8(0.28, 32, 32, 256, 6, CutoffList(wid + 1, 10.0), 8.);
+	auto e4 = spme4.ReciprocalSpace(*w);
+	ASSERT_NEAR(e4, spme8.ReciprocalSpace(*w), 1e-3*6.27009E+03*sim.GetkB());
+
+	auto& json = root["forcefields"]["electrostatic"];
+	json["grid"][2] = 128;
+	json["slab_factor"] = 4.;
+
+	std::vector<ForceField*> fflist;
+	ForceFieldManager ffm;
+	ASSERT_NO_THROW(ForceField::BuildForceFields(root["forcefields"], &ffm, fflist));
+
+	auto full = [&]() {
+		SPMEFF spme(0.28, 32, 32, 128, 6, CutoffList(wid + 1, 10.0), 4.);
+		return spme.ReciprocalSpace(*w);
+	};
+
+	auto e = ffm.EvaluateEnergy(*w).energy.electrotail;
+	ASSERT_NEAR(e4, e, 1e-10*std::abs(e));
+
+	// Charge changes leave a net charge.
+	Rand rand(2468);
+	ASSERT_NO_FATAL_FAILURE(CheckIncrementalReciprocal(*w, ffm, full, rand, e));
+
+	// Restoring periodicity rebuilds without the correction.
+	w->SetPeriodicZ(true);
+	SPMEFF periodic(0.28, 32, 32, 128, 6, CutoffList(wid + 1, 10.0), 4.);
+	ASSERT_NEAR(periodic.ReciprocalSpace(*w), ffm.EvaluateInterEnergy(*w).energy.electrotail, 1e-10*std::abs(e));
+
+	for(auto* ff : fflist)
+		delete ff;
+	delete w;
+}
+
+// Worlds with more than one non-periodic axis are rejected.
+TEST(SPMEFF, Periodicity)
+{
+	auto& sim = SimInfo::Instance();
+	sim.SetUnits(real);
+
+	Json::Value root;
+	World* w = nullptr;
+	ASSERT_NO_THROW(w = LoadNIST(root));
+	ASSERT_NE(nullptr, w);
+	w->SetPeriodicX(false);
+	w->SetPeriodicZ(false);
+	ASSERT_FALSE(SPMEFF::IsSupported(*w));
+
+	std::vector<ForceField*> fflist;
+	ForceFieldManager ffm;
+	ASSERT_THROW(ForceField::BuildForceFields(root["forcefields"], &ffm, fflist, {w}), BuildException);
+
+	auto wid = w->GetID();
+	SPMEFF spme(0.28, 32, 32, 32, 6, CutoffList(wid + 1, 10.0));
+	ASSERT_THROW(spme.ReciprocalSpace(*w), BuildException);
+
+	// A single non-periodic axis is a slab.
+	w->SetPeriodicX(true);
+	ASSERT_TRUE(SPMEFF::IsSupported(*w));
+	ASSERT_NO_THROW(spme.ReciprocalSpace(*w));
+
+	for(auto* ff : fflist)
+		delete ff;
+	delete w;
+}
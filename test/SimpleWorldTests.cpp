@@ -175,10 +175,10 @@ TEST(SimpleWorld, DefaultBehavior)
 		Position n6 =
 		{(double) coords[0], (double) coords[1], (coords[2] == 1) ? (double) n : coords[2] - 1.0};
 
-		auto& neighbors = particle->GetNeighbors();
+		auto neighbors = particle->GetNeighbors();
 		ASSERT_EQ(6, (int)neighbors.size());
 
-		for(auto& neighbor : neighbors)
+		for(auto* neighbor : neighbors)
 		{
 			auto& np = neighbor->GetPosition();
 			ASSERT_TRUE(
@@ -213,10 +213,10 @@ TEST(SimpleWorld, DefaultBehavior)
 		Position n6 =
 		{(double) coords[0], (double) coords[1], (coords[2] == 1) ? (double) n : coords[2] - 1.0};
 
-		auto& neighbors = particle->GetNeighbors();
+		auto neighbors = particle->GetNeighbors();
 		ASSERT_EQ(6, (int)neighbors.size());
 
-		for(auto& neighbor : neighbors)
+		for(auto* neighbor : neighbors)
 		{
 			auto& np = neighbor->GetPosition();
 			ASSERT_TRUE(
@@ -281,4 +281,508 @@ TEST(SimpleWorld, VolumeScaling)
 	Position newpos = 2.0*p->GetPosition(); // we will scale by 2
 	world.SetVolume(8*world.GetVolume(), true);
 	ASSERT_TRUE(is_close(newpos, p->GetPosition(),1e-11));
-}
\ No newline at end of file
+}
+TEST(SimpleWorld, CellListNeighbors)
+{
+	World world(15, 15, 15, 2.5, 0.5);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	world.PackWorld({&site1}, {1.0}, 2000, 0.5);
+	world.SetPeriodicZ(false);
+
+	// Randomize positions so cells are unevenly populated.
+	Rand rand(3456);
+	auto& H = world.GetHMatrix();
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+		world.SelectParticle(i)->SetPosition({
+			H(0,0)*rand.doub(), H(1,1)*rand.doub(), H(2,2)*rand.doub()
+		});
+
+	// Build reference list using all pairs. 
+	world.UpdateNeighborList();
+	std::vector<NeighborList> ref;
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+	{
+		auto neighbors = world.SelectParticle(i)->GetNeighbors();
+		ref.push_back(NeighborList(neighbors.begin(), neighbors.end()));
+	}
+
+	world.SetNeighborListMode(CellList);
+	ASSERT_EQ(CellList, world.GetNeighborListMode());
+	world.UpdateNeighborList();
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+	{
+		auto neighbors = world.SelectParticle(i)->GetNeighbors();
+		ASSERT_EQ(ref[i].size(), neighbors.size());
+		for(auto& n : ref[i])
+			ASSERT_TRUE(std::find(neighbors.begin(), neighbors.end(), n) != neighbors.end());
+	}
+}
+
+TEST(SimpleWorld, CellListParticleUpdate)
+{
+	World world(12, 12, 12, 2.5, 0.5);
+	world.SetNeighborListMode(CellList);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	world.PackWorld({&site1}, {1.0}, 1000, 0.5);
+
+	// Move particles around and update only their lists.
+	Rand rand(8724);
+	auto& H = world.GetHMatrix();
+	for(int i = 0; i < 500; ++i)
+	{
+		auto* p = world.DrawRandomParticle();
+		p->SetPosition({H(0,0)*rand.doub(), H(1,1)*rand.doub(), H(2,2)*rand.doub()});
+		world.UpdateNeighborList(p);
+	}
+
+	// Remove and re-insert some particles.
+	for(int i = 0; i < 50; ++i)
+	{
+		auto* p = world.DrawRandomParticle();
+		world.RemoveParticle(p);
+		p->SetPosition({H(0,0)*rand.doub(), H(1,1)*rand.doub(), H(2,2)*rand.doub()});
+		world.AddParticle(p);
+	}
+
+	// Compare against lists built from scratch.
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+	{
+		auto* pi = world.SelectParticle(i);
+		auto neighbors = pi->GetNeighbors();
+		int count = 0;
+		for(int j = 0; j < world.GetParticleCount(); ++j)
+		{
+			auto* pj = world.SelectParticle(j);
+			if(pi == pj)
+				continue;
+			Position rij = pi->GetPosition() - pj->GetPosition();
+			world.ApplyMinimumImage(&rij);
+			if(fdot(rij, rij) <= 2.5*2.5)
+			{
+				++count;
+				ASSERT_TRUE(std::find(neighbors.begin(), neighbors.end(), pj) != neighbors.end());
+			}
+		}
+		ASSERT_EQ(count, (int)neighbors.size());
+	}
+}
+
+TEST(SimpleWorld, PrimitiveArrays)
+{
+	World world(10, 10, 10, 2.0, 0.5);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	world.PackWorld({&site1}, {1.0}, 100, 0.5);
+
+	// Add a molecule with two children.
+	auto* mol = new Particle("Mol");
+	auto* a = new Particle({1, 1, 1}, {0, 0, 1}, "A");
+	auto* b = new Particle({2, 1, 1}, {0, 1, 0}, "B");
+	mol->AddChild(a);
+	mol->AddChild(b);
+	world.AddParticle(mol);
+
+	Rand rand(4523);
+	auto& H = world.GetHMatrix();
+	for(int i = 0; i < 200; ++i)
+	{
+		auto* p = world.DrawRandomParticle();
+		p->SetPosition({H(0,0)*rand.doub(), H(1,1)*rand.doub(), H(2,2)*rand.doub()});
+		if(!p->HasChildren())
+		{
+			p->SetDirector({0, 1, 0});
+			p->SetCharge(rand.doub());
+		}
+	}
+	a->SetCharge(-1.0);
+	b->SetSpecies("E1");
+
+	// Remove some particles to shift indices.
+	for(int i = 0; i < 10; ++i)
+	{
+		auto* p = world.SelectParticleBySpecies(site1.GetSpeciesID(), 0);
+		world.RemoveParticle(p);
+		delete p;
+	}
+
+	auto& soa = world.GetPrimitiveArrays();
+	ASSERT_EQ(world.GetPrimitiveCount(), (int)soa.x.size());
+	for(int i = 0; i < world.GetPrimitiveCount(); ++i)
+	{
+		auto* p = world.SelectPrimitive(i);
+		ASSERT_EQ(i, p->GetPrimitiveIndex());
+		ASSERT_EQ(p->GetPosition()[0], soa.x[i]);
+		ASSERT_EQ(p->GetPosition()[1], soa.y[i]);
+		ASSERT_EQ(p->GetPosition()[2], soa.z[i]);
+		ASSERT_EQ(p->GetDirector()[0], soa.ux[i]);
+		ASSERT_EQ(p->GetDirector()[1], soa.uy[i]);
+		ASSERT_EQ(p->GetDirector()[2], soa.uz[i]);
+		ASSERT_EQ(p->GetCharge(), soa.q[i]);
+		ASSERT_EQ(p->GetSpeciesID(), soa.species[i]);
+	}
+
+	ASSERT_EQ(-1.0, soa.q[a->GetPrimitiveIndex()]);
+	ASSERT_EQ(site1.GetSpeciesID(), soa.species[b->GetPrimitiveIndex()]);
+}
+
+TEST(SimpleWorld, SpatialSort)
+{
+	World world(12, 12, 12, 2.5, 0.5);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	world.PackWorld({&site1}, {1.0}, 1000, 0.5);
+	world.SetSortFrequency(2);
+
+	Rand rand(2312);
+	auto& H = world.GetHMatrix();
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+		world.SelectParticle(i)->SetPosition({H(0,0)*rand.doub(), H(1,1)*rand.doub(), H(2,2)*rand.doub()});
+
+	auto& counters = SimInfo::Instance().GetCounterMap();
+	long count = counters.count("nlist_sort") ? counters.at("nlist_sort") : 0;
+	world.UpdateNeighborList();
+	world.UpdateNeighborList();
+	ASSERT_EQ(count + 1, counters.at("nlist_sort"));
+	world.UpdateNeighborList();
+	world.UpdateNeighborList();
+	ASSERT_EQ(count + 2, counters.at("nlist_sort"));
+
+	// Primitives and their neighbors follow storage order.
+	auto& soa = world.GetPrimitiveArrays();
+	for(int i = 0; i < world.GetPrimitiveCount(); ++i)
+	{
+		auto* pi = world.SelectPrimitive(i);
+		ASSERT_EQ(i, pi->GetPrimitiveIndex());
+		ASSERT_EQ(pi->GetPosition()[0], soa.x[i]);
+
+		auto neighbors = pi->GetNeighbors();
+		for(size_t j = 1; j < neighbors.size(); ++j)
+			ASSERT_LT(neighbors[j-1]->GetPrimitiveIndex(), neighbors[j]->GetPrimitiveIndex());
+
+		int n = 0;
+		for(int j = 0; j < world.GetPrimitiveCount(); ++j)
+		{
+			auto* pj = world.SelectPrimitive(j);
+			if(pi == pj)
+				continue;
+			Position rij = pi->GetPosition() - pj->GetPosition();
+			world.ApplyMinimumImage(&rij);
+			if(fdot(rij, rij) <= 2.5*2.5)
+				++n;
+		}
+		ASSERT_EQ(n, (int)neighbors.size());
+	}
+
+	// Neighboring storage locations should be spatially close.
+	double d = 0;
+	for(int i = 1; i < world.GetPrimitiveCount(); ++i)
+	{
+		Position rij = world.SelectPrimitive(i)->GetPosition() - world.SelectPrimitive(i-1)->GetPosition();
+		world.ApplyMinimumImage(&rij);
+		d += fnorm(rij);
+	}
+	ASSERT_LT(d/(world.GetPrimitiveCount() - 1), 2.5);
+}
+
+TEST(SimpleWorld, SpeciesIndex)
+{
+	World world(10, 10, 10, 2.0, 0.5);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	Particle site2({0, 0, 0}, {0, 1, 0}, "E2");
+	world.PackWorld({&site1, &site2}, {0.5, 0.5}, 200, 0.5);
+
+	int s1 = site1.GetSpeciesID();
+	int s2 = site2.GetSpeciesID();
+
+	// Add a molecule containing species E1 and E2.
+	auto* mol = new Particle("Mol");
+	mol->AddChild(new Particle({1, 1, 1}, {0, 0, 1}, "E1"));
+	mol->AddChild(new Particle({2, 1, 1}, {0, 0, 1}, "E2"));
+	world.AddParticle(mol);
+	int sm = mol->GetSpeciesID();
+
+	// Swap species and remove some particles.
+	for(int i = 0; i < 20; ++i)
+		world.SelectParticleBySpecies(s1, i)->SetSpeciesID(s2);
+	for(int i = 0; i < 10; ++i)
+	{
+		auto* p = world.SelectParticleBySpecies(s2, 0);
+		world.RemoveParticle(p);
+		delete p;
+	}
+
+	ASSERT_EQ(80, world.GetParticleCountBySpecies(s1));
+	ASSERT_EQ(110, world.GetParticleCountBySpecies(s2));
+	ASSERT_EQ(1, world.GetParticleCountBySpecies(sm));
+	ASSERT_EQ(81, world.GetPrimitiveCountBySpecies(s1));
+	ASSERT_EQ(111, world.GetPrimitiveCountBySpecies(s2));
+	ASSERT_EQ(0, world.GetPrimitiveCountBySpecies(sm));
+	ASSERT_EQ(mol, world.SelectParticleBySpecies(sm, 0));
+
+	for(int i = 0; i < world.GetParticleCountBySpecies(s2); ++i)
+		ASSERT_EQ(s2, world.SelectParticleBySpecies(s2, i)->GetSpeciesID());
+	for(int i = 0; i < world.GetPrimitiveCountBySpecies(s1); ++i)
+		ASSERT_EQ(s1, world.SelectPrimitiveBySpecies(s1, i)->GetSpeciesID());
+
+	for(int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(s1, world.DrawRandomParticleBySpecies(s1)->GetSpeciesID());
+		ASSERT_EQ(s2, world.DrawRandomPrimitiveBySpecies(s2)->GetSpeciesID());
+	}
+}
+
+TEST(SimpleWorld, RemoveParticleIndexing)
+{
+	World world(10, 10, 10, 2.0, 0.5);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	Particle site2({0, 0, 0}, {0, 1, 0}, "E2");
+	world.PackWorld({&site1, &site2}, {0.5, 0.5}, 500, 0.5);
+
+	int s1 = site1.GetSpeciesID();
+	int s2 = site2.GetSpeciesID();
+
+	// Remove and re-add random particles, keeping a stash.
+	Rand rand(9431);
+	ParticleList removed;
+	for(int i = 0; i < 2000; ++i)
+	{
+		if(removed.size() && rand.doub() < 0.5)
+		{
+			world.AddParticle(removed.back());
+			removed.pop_back();
+		}
+		else
+		{
+			auto* p = world.DrawRandomParticle();
+			world.RemoveParticle(p);
+			removed.push_back(p);
+		}
+	}
+
+	ASSERT_EQ(500, world.GetParticleCount() + (int)removed.size());
+	ASSERT_EQ(world.GetParticleCount(), world.GetPrimitiveCount());
+	ASSERT_EQ(world.GetParticleCount(), 
+		world.GetParticleCountBySpecies(s1) + world.GetParticleCountBySpecies(s2));
+
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+	{
+		auto* p = world.SelectParticle(i);
+		ASSERT_EQ(i, p->GetWorldIndex());
+		ASSERT_EQ(p, world.SelectPrimitive(p->GetPrimitiveIndex()));
+		ASSERT_EQ(&world, p->GetWorld());
+
+		// Neighbor lists survive relocation of primitives.
+		int count = 0;
+		for(int j = 0; j < world.GetParticleCount(); ++j)
+		{
+			auto* pj = world.SelectParticle(j);
+			if(p == pj)
+				continue;
+			Position rij = p->GetPosition() - pj->GetPosition();
+			world.ApplyMinimumImage(&rij);
+			if(fdot(rij, rij) <= 2.0*2.0)
+			{
+				++count;
+				ASSERT_TRUE(p->IsNeighbor(*pj));
+				ASSERT_TRUE(pj->IsNeighbor(*p));
+			}
+		}
+		ASSERT_EQ(count, (int)p->GetNeighbors().size());
+	}
+
+	for(int s : {s1, s2})
+		for(int i = 0; i < world.GetParticleCountBySpecies(s); ++i)
+		{
+			auto* p = world.SelectParticleBySpecies(s, i);
+			ASSERT_EQ(s, p->GetSpeciesID());
+			ASSERT_EQ(p, world.SelectParticle(p->GetWorldIndex()));
+		}
+
+	for(auto* p : removed)
+	{
+		ASSERT_EQ(-1, p->GetWorldIndex());
+		ASSERT_EQ(-1, p->GetPrimitiveIndex());
+		ASSERT_EQ(0, (int)p->GetNeighbors().size());
+		delete p;
+	}
+}
+
+TEST(SimpleWorld, SkinTuning)
+{
+	World world(10, 10, 10, 3.0, 0.5);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	world.PackWorld({&site1}, {1.0}, 300, 0.3);
+	world.SetSkinTuning(true, 1);
+	ASSERT_TRUE(world.GetSkinTuning());
+
+	auto rcut = world.GetNeighborRadius() - world.GetSkinThickness();
+	bool changed = false;
+	for(int i = 0; i < 50; ++i)
+	{
+		auto skin = world.GetSkinThickness();
+		world.UpdateNeighborList();
+		world.TuneSkinThickness();
+		changed |= (skin != world.GetSkinThickness());
+
+		// Interaction cutoff is preserved and skin stays bounded.
+		ASSERT_NEAR(rcut, world.GetNeighborRadius() - world.GetSkinThickness(), 1e-10);
+		ASSERT_GE(world.GetSkinThickness(), 0.05*rcut - 1e-10);
+		ASSERT_LE(world.GetSkinThickness(), rcut + 1e-10);
+	}
+	ASSERT_TRUE(changed);
+
+	// Neighbor lists match the tuned radius.
+	auto ncut = world.GetNeighborRadius();
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+	{
+		auto* p = world.SelectParticle(i);
+		int count = 0;
+		for(int j = 0; j < world.GetParticleCount(); ++j)
+		{
+			auto* pj = world.SelectParticle(j);
+			if(p == pj)
+				continue;
+			Position rij = p->GetPosition() - pj->GetPosition();
+			world.ApplyMinimumImage(&rij);
+			if(fdot(rij, rij) <= ncut*ncut)
+				++count;
+		}
+		ASSERT_EQ(count, (int)p->GetNeighbors().size());
+	}
+
+	// Tuning settings are serialized.
+	Json::Value json;
+	world.Serialize(json);
+	ASSERT_EQ(1, json["skin_tune"]["window"].asInt());
+}
+
+TEST(SimpleWorld, VolumeScalingNeighborReuse)
+{
+	World world(10, 10, 10, 3.0, 0.6);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	world.PackWorld({&site1}, {1.0}, 400, 0.4);
+	world.UpdateNeighborList();
+
+	auto rcut = world.GetNeighborRadius() - world.GetSkinThickness();
+	auto& counters = SimInfo::Instance().GetCounterMap();
+	auto reuses = [&](){ 
+		auto it = counters.find("nlist_reuse"); 
+		return it == counters.end() ? 0 : it->second; 
+	};
+
+	// All pairs within the interaction cutoff must be listed.
+	auto check = [&]()
+	{
+		for(int i = 0; i < world.GetParticleCount(); ++i)
+			for(int j = i + 1; j < world.GetParticleCount(); ++j)
+			{
+				auto* pi = world.SelectParticle(i);
+				auto* pj = world.SelectParticle(j);
+				Position rij = pi->GetPosition() - pj->GetPosition();
+				world.ApplyMinimumImage(&rij);
+				if(fdot(rij, rij) < rcut*rcut)
+				{
+					ASSERT_TRUE(pi->IsNeighbor(*pj));
+					ASSERT_TRUE(pj->IsNeighbor(*pi));
+				}
+			}
+	};
+
+	auto snapshot = [&]()
+	{
+		std::vector<std::vector<Particle*>> lists;
+		for(auto* p : world)
+		{
+			auto neighbors = p->GetNeighbors();
+			lists.emplace_back(neighbors.begin(), neighbors.end());
+			std::sort(lists.back().begin(), lists.back().end());
+		}
+		return lists;
+	};
+
+	// Small contractions and expansions reuse the list.
+	auto v0 = world.GetVolume();
+	for(double f : {0.995, 1.005, 0.99, 1.01})
+	{
+		auto r = reuses();
+		world.SetVolume(f*v0, true);
+		ASSERT_EQ(r + 1, reuses());
+		check();
+		world.SetVolume(v0, true);
+		check();
+	}
+
+	// A large contraction forces a rebuild and the prior list 
+	// is restored on rejection.
+	auto before = snapshot();
+	auto p = world.SelectParticle(7);
+	auto pos = p->GetPosition();
+	auto r = reuses();
+	world.SetVolume(0.5*v0, true);
+	ASSERT_EQ(r, reuses());
+	check();
+	ASSERT_TRUE(before != snapshot());
+	world.RestoreVolume(v0);
+	ASSERT_NEAR(v0, world.GetVolume(), 1e-10);
+	ASSERT_TRUE(is_close(pos, p->GetPosition(), 1e-10));
+	ASSERT_TRUE(before == snapshot());
+	check();
+
+	// Displacement budget is consistent after restoring.
+	world.SetVolume(0.995*v0, true);
+	check();
+	world.RestoreVolume(v0);
+	ASSERT_TRUE(before == snapshot());
+}
+
+TEST(SimpleWorld, VolumeScalingRestoreSorted)
+{
+	World world(10, 10, 10, 3.0, 0.6);
+	Particle site1({0, 0, 0}, {1, 0, 0}, "E1");
+	world.PackWorld({&site1}, {1.0}, 400, 0.4);
+	world.SetSortFrequency(1);
+
+	// Scatter particles so reordering would permute primitives.
+	Rand rand(5821);
+	auto& H = world.GetHMatrix();
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+		world.SelectParticle(i)->SetPosition({H(0,0)*rand.doub(), H(1,1)*rand.doub(), H(2,2)*rand.doub()});
+	world.UpdateNeighborList();
+	for(int i = 0; i < world.GetParticleCount(); ++i)
+		world.SelectParticle(i)->SetPosition({H(0,0)*rand.doub(), H(1,1)*rand.doub(), H(2,2)*rand.doub()});
+
+	ParticleList primitives;
+	std::vector<std::vector<Particle*>> lists;
+	std::vector<Position> checkpoints;
+	for(int i = 0; i < world.GetPrimitiveCount(); ++i)
+	{
+		auto* p = world.SelectPrimitive(i);
+		primitives.push_back(p);
+		auto neighbors = p->GetNeighbors();
+		lists.emplace_back(neighbors.begin(), neighbors.end());
+		std::sort(lists.back().begin(), lists.back().end());
+		checkpoints.push_back(p->GetCheckpoint());
+	}
+
+	// A rejected contraction that rebuilds the list must not reorder.
+	auto& counters = SimInfo::Instance().GetCounterMap();
+	long count = counters.count("nlist_sort") ? counters.at("nlist_sort") : 0;
+	auto v0 = world.GetVolume();
+	world.SetVolume(0.5*v0, true);
+	world.RestoreVolume(v0);
+	ASSERT_EQ(count, counters.count("nlist_sort") ? counters.at("nlist_sort") : 0);
+
+	for(int i = 0; i < world.GetPrimitiveCount(); ++i)
+	{
+		auto* p = world.SelectPrimitive(i);
+		ASSERT_EQ(primitives[i], p);
+		ASSERT_EQ(i, p->GetPrimitiveIndex());
+		auto neighbors = p->GetNeighbors();
+		std::vector<Particle*> list(neighbors.begin(), neighbors.end());
+		std::sort(list.begin(), list.end());
+		ASSERT_TRUE(lists[i] == list);
+		ASSERT_TRUE(is_close(checkpoints[i], p->GetCheckpoint(), 1e-10));
+	}
+
+	// The deferred reorder happens on the next rebuild.
+	world.UpdateNeighborList();
+	ASSERT_EQ(count + 1, counters.at("nlist_sort"));
+}
@@ -97,9 +97,9 @@ TEST(Site, Neighbors)
 
 	// Verify
 	std::vector<std::string> vals = {"L2", "L3", "L4"};
-	auto& neighbors = s1.GetNeighbors();
+	auto neighbors = s1.GetNeighbors();
 	int i = 0;
-	for(auto& neighbor: neighbors)
+	for(auto* neighbor: neighbors)
 	{
 		auto id = neighbor->GetSpecies();
 
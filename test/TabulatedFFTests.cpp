@@ -0,0 +1,152 @@
+#include "../src/ForceFields/TabulatedFF.h"
+#include "../src/ForceFields/LennardJonesFF.h"
+#include "../src/ForceFields/DSFFF.h"
+#include "../src/ForceFields/EwaldFF.h"
+#include "../src/ForceFields/FENEFF.h"
+#include "../src/ForceFields/ForceFieldManager.h"
+#include "../src/Simulation/SimException.h"
+#include "../src/Particles/Particle.h"
+#include "json/json.h"
+#include "gtest/gtest.h"
+
+using namespace SAPHRON;
+
+TEST(TabulatedFF, LennardJones)
+{
+	Particle s1({0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, "L1");
+	Particle s2({0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, "L1");
+
+	LennardJonesFF lj(1.0, 1.0, {2.5, 3.0});
+	TabulatedFF ff(new LennardJonesFF(1.0, 1.0, {2.5, 3.0}), s1, s2, 4096, false, 0.8);
+
+	ASSERT_EQ(4096, ff.GetPoints());
+	ASSERT_LT(ff.GetMaxEnergyError(), 1e-6);
+	ASSERT_LT(ff.GetMaxVirialError(), 1e-5);
+	ASSERT_EQ(lj.GetCutoffs(), ff.GetCutoffs());
+	ASSERT_EQ(lj.EnergyTailCorrection(1), ff.EnergyTailCorrection(1));
+
+	// Compare to exact potential inside, outside and below the table.
+	for(unsigned int wid = 0; wid < 2; ++wid)
+	{
+		for(int i = 0; i < 300; ++i)
+		{
+			Position rij{0.7 + 0.01*i, 0.1, 0.0};
+			auto exact = lj.Evaluate(s1, s2, rij, wid);
+			auto tab = ff.Evaluate(s1, s2, rij, wid);
+			ASSERT_NEAR(exact.energy, tab.energy, 1e-6);
+			ASSERT_NEAR(exact.virial, tab.virial, 1e-5);
+		}
+	}
+}
+
+TEST(TabulatedFF, ChargeScaling)
+{
+	Particle s1({0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, "L1");
+	Particle s2({0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, "L1");
+	s1.SetCharge(1.0);
+	s2.SetCharge(1.0);
+
+	DSFFF dsf(0.2, {10.0});
+	TabulatedFF ff(new DSFFF(0.2, {10.0}), s1, s2, 4096, true);
+
+	s1.SetCharge(0.5);
+	s2.SetCharge(-2.0);
+	for(int i = 0; i < 100; ++i)
+	{
+		Position rij{2.0 + 0.1*i, 0.0, 0.0};
+		auto exact = dsf.Evaluate(s1, s2, rij, 0);
+		auto tab = ff.Evaluate(s1, s2, rij, 0);
+		ASSERT_NEAR(exact.energy, tab.energy, 1e-7*fabs(exact.energy) + 1e-9);
+		ASSERT_NEAR(exact.virial, tab.virial, 1e-6*fabs(exact.virial) + 1e-9);
+	}
+}
+
+TEST(TabulatedFF, Build)
+{
+	Particle s1({0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, "L1");
+	ForceFieldManager ffm;
+
+	Json::Value json;
+	Json::Reader reader;
+	ASSERT_TRUE(reader.parse(R"({
+		"type" : "LennardJones",
+		"sigma" : 1.0,
+		"epsilon" : 1.0,
+		"rcut" : [2.5],
+		"species" : ["L1", "L1"],
+		"tabulate" : { "points" : 1000 }
+	})", json));
+
+	ForceField* ff = nullptr;
+	ASSERT_NO_THROW(ff = ForceField::BuildNonBonded(json, &ffm));
+	auto* tff = dynamic_cast<TabulatedFF*>(ff);
+	ASSERT_NE(nullptr, tff);
+	ASSERT_NE(nullptr, dynamic_cast<const LennardJonesFF*>(tff->GetForceField()));
+	ASSERT_EQ("Tabulated", ffm.GetKernelName());
+
+	Json::Value out;
+	ff->Serialize(out);
+	ASSERT_EQ("LennardJones", out["type"].asString());
+	ASSERT_EQ(1000, out["tabulate"]["points"].asInt());
+	ffm.RemoveNonBondedForceField("L1", "L1");
+	delete ff;
+
+	// Forcefields without cutoffs need a table range.
+	ASSERT_TRUE(reader.parse(R"({
+		"type" : "FENE",
+		"epsilon" : 1.0,
+		"sigma" : 1.0,
+		"kspring" : 30.0,
+		"rmax" : 1.5,
+		"species" : ["L1", "L1"],
+		"tabulate" : { "points" : 1000 }
+	})", json));
+	ASSERT_THROW(ForceField::BuildBonded(json, &ffm), BuildException);
+
+	json["tabulate"]["rmin"] = 0.7;
+	json["tabulate"]["rmax"] = 1.45;
+	ASSERT_NO_THROW(ff = ForceField::BuildBonded(json, &ffm));
+	ASSERT_LT(dynamic_cast<TabulatedFF*>(ff)->GetMaxEnergyError(), 1e-4);
+	ffm.RemoveBondedForceField("L1", "L1");
+	delete ff;
+}
+
+// Electrostatics are probed with unit charges on any species, and the 
+// wrapped forcefield remains reachable (e.g. for tuned Ewald reporting).
+TEST(TabulatedFF, BuildElectrostatic)
+{
+	Particle s1({0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, "T1");
+	Particle s2({0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, "T2");
+	s1.SetCharge(0.5);
+	s2.SetCharge(-2.0);
+	ForceFieldManager ffm;
+
+	Json::Value json;
+	Json::Reader reader;
+	ASSERT_TRUE(reader.parse(R"({
+		"type" : "Ewald",
+		"alpha" : 0.3,
+		"kmax" : [3, 3, 3],
+		"rcut" : [9.0],
+		"tabulate" : { "points" : 4096 }
+	})", json));
+
+	ForceField* ff = nullptr;
+	ASSERT_NO_THROW(ff = ForceField::BuildElectrostatic(json, &ffm));
+	auto* tff = dynamic_cast<TabulatedFF*>(ff);
+	ASSERT_NE(nullptr, tff);
+	ASSERT_NE(nullptr, dynamic_cast<const EwaldFF*>(tff->GetForceField()));
+
+	EwaldFF ewald(0.3, 3, 3, 3, {9.0});
+	for(int i = 0; i < 60; ++i)
+	{
+		Position rij{2.5 + 0.1*i, 0.0, 0.0};
+		auto exact = ewald.Evaluate(s1, s2, rij, 0);
+		auto tab = ff->Evaluate(s1, s2, rij, 0);
+		ASSERT_NEAR(exact.energy, tab.energy, 1e-7*fabs(exact.energy) + 1e-9);
+		ASSERT_NEAR(exact.virial, tab.virial, 1e-6*fabs(exact.virial) + 1e-9);
+	}
+
+	ffm.ResetElectrostaticForceField();
+	delete ff;
+}